@@ -8,12 +8,20 @@
 #include <hatch/utility/owning.hh>
 #include <hatch/core/handle.hh>
 
+#include <memory> // std::aligned_storage
+#include <new> // placement new
+
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   template <uint64_t S>
   class allocated : public owner<allocated<S>, handle<S>> {
   public:
     friend class allocator;
+    friend class region;
+
+    template <class T>
+    friend class pointer;
 
   protected:
     allocated();
@@ -37,6 +45,7 @@ namespace hatch {
     std::aligned_storage_t<S> _data;
   };
 
+} // inline namespace HATCH_SLABTAG
 } // namespace hatch
 
 #endif // HATCH_ALLOCATED_HH
\ No newline at end of file
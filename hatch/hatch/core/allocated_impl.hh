@@ -6,6 +6,7 @@
 #endif
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   template <uint64_t S>
   allocated<S>::allocated() :
@@ -39,6 +40,7 @@ namespace hatch {
     reinterpret_cast<T&>(_data).~T();
   }
 
+} // inline namespace HATCH_SLABTAG
 } // namespace hatch
 
 #endif // HATCH_ALLOCATED_IMPL_HH
\ No newline at end of file
@@ -2,27 +2,73 @@
 #define HATCH_ALLOCATOR_HH
 
 #ifndef HATCH_MEMORY_HH
-#error "do not include pointer.hh directly. include memory.hh instead."
+#error "do not include allocator.hh directly. include memory.hh instead."
 #endif
 
+#include <hatch/core/slabs.hh>
 #include <hatch/utility/list.hh>
 #include <hatch/utility/tree.hh>
+#include <hatch/utility/integral.hh>
 
+#include <atomic> // std::atomic
 #include <memory> // std::aligned_storage
+#include <thread> // std::thread::id
+#include <vector> // std::vector
 
 #include <cstddef> // std::max_align_t, size_t
 #include <cstdint> // uint64_t
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   class allocator {
   public:
-    static constexpr auto pagesize = 16384lu;
+    friend class region;
+
+    template <class T, widths Width>
+    friend class compressed;
+
+    enum class pagings {
+      small,
+      huge,
+    };
+
+    static constexpr auto smallpage = 16384lu;
+    static constexpr auto hugepage = 2097152lu;
+
+    // a snapshot of one size class. every field is exact on its own, but they
+    // are read one at a time, so they can be a moment apart from each other.
+    class statistic {
+    public:
+      uint64_t _size;
+      uint64_t _bytes;
+      uint64_t _mapped;
+      uint64_t _used;
+      uint64_t _free;
+      uint64_t _pages;
+      uint64_t _peak;
+      uint64_t _created;
+      uint64_t _destroyed;
+    };
+
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
 
   public:
-    allocator();
+    explicit allocator(pagings paging = pagings::small, uint64_t reach = 0);
     ~allocator();
 
+    allocator(allocator&& moved) = delete;
+    allocator& operator=(allocator&& moved) = delete;
+
+    allocator(const allocator& copied) = delete;
+    allocator& operator=(const allocator& copied) = delete;
+
+    ////////////////
+    // Interface. //
+    ////////////////
+
   public:
     template <class T, class ...Args>
     pointer<T> create(Args&&... args);
@@ -30,28 +76,176 @@ namespace hatch {
     template <class T>
     void destroy(pointer<T>& ptr);
 
+    template <class T, class ...Args>
+    std::vector<pointer<T>> create_n(uint64_t count, const Args&... args);
+
+    template <class T>
+    void destroy_n(std::vector<pointer<T>>& ptrs);
+
+    uint64_t compact();
+    void drain();
+
+    uint64_t pagesize() const;
+    std::byte* base() const;
+
+    std::vector<statistic> statistics() const;
+
+    /////////////
+    // Thread. //
+    /////////////
+
   private:
-    template <uint16_t ...Sizes>
-    class allocations;
+    std::thread::id _thread;
+
+    ////////////
+    // Pages. //
+    ////////////
+
+  private:
+    pagings _paging;
+
+    ////////////
+    // Slabs. //
+    ////////////
+
+  private:
+    class page : public list_node<page> {
+    public:
+      page();
+
+      bool is_live(uint64_t index) const;
+      void make_live(uint64_t index);
+      void make_free(uint64_t index);
+
+      // a bitmap of the live slots follows the header. pages that belong to a
+      // region don't have one, they just point back at their region.
+      uint64_t _used;
+      region* _region;
+    };
+
+    page* page_of(void* address) const;
+
+    // with a reach, every page comes out of a single range of address space
+    // that is set aside up front, so that anything in it can be addressed by
+    // its distance from the base. once the range is used up, creating
+    // anything that needs another page throws std::bad_alloc.
+    class reservation {
+    public:
+      reservation(uint64_t reach, uint64_t pagesize);
+      ~reservation();
+
+      void* take();
+      void give(void* memory);
+
+      std::byte* _base;
+      std::byte* _mapped;
+      uint64_t _reach;
+      uint64_t _pagesize;
+      std::byte* _next;
+      std::byte* _end;
+      list<page> _released;
+    };
+
+    void* map_page();
+    void unmap_page(void* memory);
 
     template <uint64_t S>
     class allocation {
     public:
       union node {
       public:
+        node() {}
+        ~node() {}
+
         allocated<S> _allocated;
         liberated<S> _liberated;
+        node* _chained;
       };
 
+      explicit allocation(allocator* owner);
+      ~allocation();
+
+      allocated<S>* acquire();
+      allocated<S>* take();
+      void release(allocated<S>* released);
+      void defer(allocated<S>* released);
+      void drain();
+      uint64_t compact();
+
+      node* carve(uint64_t count);
+      void release_n(std::vector<allocated<S>*>& released);
+      void defer_n(std::vector<allocated<S>*>& released);
+
+      void liberate(node* freed);
+      void vacate(page* vacated);
+      void map();
+      void purge(page* purged);
+      uint64_t retire(page* retired);
+
+      page* page_of(void* address);
+      node* first(page* owner);
+      node* carved(page* owner);
+
+      // the counters are only ever written by the owning thread, except for
+      // destructions, which can come from anywhere.
+      class counters {
+      public:
+        std::atomic<uint64_t> _used{0};
+        std::atomic<uint64_t> _pages{0};
+        std::atomic<uint64_t> _peak{0};
+        std::atomic<uint64_t> _created{0};
+        std::atomic<uint64_t> _destroyed{0};
+      };
+
+      static void tally(std::atomic<uint64_t>& counter, int64_t delta);
+      void occupy(int64_t delta);
+      statistic statistics() const;
+
+      allocator* _allocator;
+      uint64_t _pagesize;
+      uint64_t _bitmap;
+      uint64_t _offset;
+      uint64_t _capacity;
+
       tree<liberated<S>> _free;
-      liberated<S>* _next;
+      list<page> _pages;
+      list<page> _idle;
+      page* _spare;
+      node* _next;
+      node* _end;
+      std::atomic<bool> _relocatable;
+
+      std::atomic<node*> _remote;
+      counters _counters;
+    };
+
+    template <class Slabs>
+    class allocations;
+
+    template <uint64_t ...Sizes>
+    class allocations<slabs<Sizes...>> : public allocation<Sizes>... {
+    public:
+      explicit allocations(allocator* owner);
+
+      uint64_t compact();
+      void drain();
+      void statistics(std::vector<statistic>& result) const;
     };
 
-    //using bucketlist = buckets<4, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 6144, 8192, 12288, 16384>;
+    template <uint64_t S>
+    allocation<S>& slab_allocation();
+
+    template <class T>
+    allocation<slab<T>>& typed_allocation();
 
+    static void* map_huge();
+    static void unmap_huge(void* memory);
 
+    reservation _reservation;
+    allocations<slablist> _allocations;
   };
 
+} // inline namespace HATCH_SLABTAG
 }
 
 #endif // HATCH_ALLOCATOR_HH
@@ -5,204 +5,745 @@
 #error "do not include allocator_impl.hh directly.  include memory.hh instead."
 #endif
 
-#include <iostream>
+#include <algorithm> // std::min, std::sort
+#include <functional> // std::greater
+#include <initializer_list> // std::initializer_list
 #include <memory> // std::aligned_alloc
+#include <new> // placement new, std::bad_alloc
+#include <thread> // std::this_thread
+#include <type_traits> // std::is_base_of_v, std::is_trivially_copyable_v
 #include <utility> // std::forward
+#include <vector> // std::vector
 
 #include <cassert> // assert
-#include <cstring> // memcpy
+#include <cstdint> // uintptr_t
+#include <cstdlib> // std::aligned_alloc, std::free
+#include <cstring> // std::memcpy
+
+#include <sys/mman.h> // madvise
+#include <unistd.h> // sysconf
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  inline allocator::allocator(pagings paging, uint64_t reach) :
+      _thread{std::this_thread::get_id()},
+      _paging{paging},
+      _reservation{reach, paging == pagings::huge ? hugepage : smallpage},
+      _allocations{this} {
+  }
+
+  inline allocator::~allocator() {
+    drain();
+  }
+
+  ////////////////
+  // Interface. //
+  ////////////////
+
+  template <class T, class ...Args>
+  pointer<T> allocator::create(Args&&... args) {
+    assert(std::this_thread::get_id() == _thread);
+    auto& allocation = typed_allocation<T>();
+    auto* created = allocation.acquire();
+    created->template create<T>(std::forward<Args>(args)...);
+    allocation.tally(allocation._counters._created, 1);
+    return pointer<T>{created, this};
+  }
+
+  template <class T>
+  void allocator::destroy(pointer<T>& ptr) {
+    if (auto* destroyed = ptr._owner) {
+      // objects that were created in a region go back to it.
+      if (auto* owner = page_of(destroyed)->_region) {
+        owner->destroy(destroyed);
+        return;
+      }
+
+      destroyed->template destroy<T>();
+      destroyed->disown_all();
+
+      // the slot itself can only be touched by the thread that owns this
+      // allocator. anyone else queues it up for the owner to collect.
+      auto& allocation = slab_allocation<slab<T>>();
+      allocation._counters._destroyed.fetch_add(1, std::memory_order_relaxed);
+      if (std::this_thread::get_id() == _thread) {
+        allocation.release(destroyed);
+      } else {
+        allocation.defer(destroyed);
+      }
+    }
+  }
+
+  template <class T, class ...Args>
+  std::vector<pointer<T>> allocator::create_n(uint64_t count, const Args&... args) {
+    assert(std::this_thread::get_id() == _thread);
+    auto& allocation = typed_allocation<T>();
+
+    // objects are built in runs of adjacent slots carved straight off a page,
+    // so none of them has to go through the free tree.
+    std::vector<pointer<T>> created;
+    created.reserve(count);
+    while (created.size() < count) {
+      auto run = std::min(count - created.size(), allocation._capacity);
+      auto* carved = allocation.carve(run);
+      for (auto* slot = carved; slot != carved + run; ++slot) {
+        auto* constructed = new (&slot->_allocated) allocated<slab<T>>{};
+        constructed->template create<T>(args...);
+        created.push_back(pointer<T>{constructed, this});
+      }
+    }
+    allocation.tally(allocation._counters._created, count);
+    return created;
+  }
+
+  template <class T>
+  void allocator::destroy_n(std::vector<pointer<T>>& ptrs) {
+    std::vector<allocated<slab<T>>*> destroyed;
+    destroyed.reserve(ptrs.size());
+    for (auto& ptr : ptrs) {
+      if (auto* owner = ptr._owner) {
+        if (auto* home = page_of(owner)->_region) {
+          home->destroy(owner);
+          continue;
+        }
+        owner->template destroy<T>();
+        owner->disown_all();
+        destroyed.push_back(owner);
+      }
+    }
+
+    auto& allocation = slab_allocation<slab<T>>();
+    allocation._counters._destroyed.fetch_add(destroyed.size(), std::memory_order_relaxed);
+    if (std::this_thread::get_id() == _thread) {
+      allocation.release_n(destroyed);
+    } else {
+      allocation.defer_n(destroyed);
+    }
+  }
+
+  inline uint64_t allocator::compact() {
+    assert(std::this_thread::get_id() == _thread);
+    _allocations.drain();
+    return _allocations.compact();
+  }
+
+  inline void allocator::drain() {
+    assert(std::this_thread::get_id() == _thread);
+    _allocations.drain();
+  }
+
+  inline uint64_t allocator::pagesize() const {
+    return _paging == pagings::huge ? hugepage : smallpage;
+  }
+
+  inline std::byte* allocator::base() const {
+    return _reservation._base;
+  }
+
+  inline std::vector<allocator::statistic> allocator::statistics() const {
+    // only reads counters, so any thread can take a snapshot at any time.
+    std::vector<statistic> result;
+    _allocations.statistics(result);
+    return result;
+  }
+
+  ////////////
+  // Slabs. //
+  ////////////
+
+  inline allocator::page::page() :
+      list_node<page>{},
+      _used{0},
+      _region{nullptr} {
+  }
+
+  inline allocator::page* allocator::page_of(void* address) const {
+    return reinterpret_cast<page*>(reinterpret_cast<uintptr_t>(address) & ~(pagesize() - 1));
+  }
+
+  inline bool allocator::page::is_live(uint64_t index) const {
+    auto* bitmap = reinterpret_cast<const uint64_t*>(this + 1);
+    return (bitmap[index / 64] >> (index % 64)) & 1;
+  }
+
+  inline void allocator::page::make_live(uint64_t index) {
+    auto* bitmap = reinterpret_cast<uint64_t*>(this + 1);
+    bitmap[index / 64] |= uint64_t{1} << (index % 64);
+  }
+
+  inline void allocator::page::make_free(uint64_t index) {
+    auto* bitmap = reinterpret_cast<uint64_t*>(this + 1);
+    bitmap[index / 64] &= ~(uint64_t{1} << (index % 64));
+  }
+
+  inline allocator::reservation::reservation(uint64_t reach, uint64_t pagesize) :
+      _base{nullptr},
+      _mapped{nullptr},
+      _reach{reach},
+      _pagesize{pagesize},
+      _next{nullptr},
+      _end{nullptr},
+      _released{} {
+    if (!reach) {
+      return;
+    }
+
+    // the range is only reserved, nothing is backed until it's touched. an
+    // extra page's worth lets the base be aligned to the page size.
+    auto* mapped = mmap(nullptr, reach + pagesize, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mapped == MAP_FAILED) {
+      throw std::bad_alloc{};
+    }
+    _mapped = static_cast<std::byte*>(mapped);
+    _base = reinterpret_cast<std::byte*>(
+        (reinterpret_cast<uintptr_t>(_mapped) + pagesize - 1) & ~(pagesize - 1));
+    _next = _base;
+    _end = _base + reach / pagesize * pagesize;
+
+#ifdef MADV_HUGEPAGE
+    if (pagesize == hugepage) {
+      madvise(_base, _end - _base, MADV_HUGEPAGE);
+    }
+#endif
+  }
+
+  inline allocator::reservation::~reservation() {
+    if (_mapped) {
+      while (auto* popped = _released.pop_front()) {
+        popped->~page();
+      }
+      munmap(_mapped, _reach + _pagesize);
+    }
+  }
+
+  inline void* allocator::reservation::take() {
+    if (auto* released = _released.pop_front()) {
+      released->~page();
+      return released;
+    }
+    if (_next == _end) {
+      return nullptr;
+    }
+    auto* taken = _next;
+    _next += _pagesize;
+    return taken;
+  }
+
+  inline void allocator::reservation::give(void* memory) {
+    // the page stays in the range for the next taker, but its memory goes
+    // back to the os. only the header gets faulted back in.
+    madvise(memory, _pagesize, MADV_DONTNEED);
+    _released.push_back(*new (memory) page{});
+  }
+
+  inline void* allocator::map_page() {
+    // a reach is a hard limit, and a small one runs out long before the os
+    // does, so not getting a page is an ordinary failure to allocate.
+    void* memory;
+    if (_reservation._base) {
+      memory = _reservation.take();
+    } else if (_paging == pagings::huge) {
+      memory = map_huge();
+    } else {
+      memory = std::aligned_alloc(smallpage, smallpage);
+    }
+    if (!memory) {
+      throw std::bad_alloc{};
+    }
+    return memory;
+  }
+
+  inline void allocator::unmap_page(void* memory) {
+    if (_reservation._base) {
+      _reservation.give(memory);
+    } else if (_paging == pagings::huge) {
+      unmap_huge(memory);
+    } else {
+      std::free(memory);
+    }
+  }
+
+  inline void* allocator::map_huge() {
+#ifdef MAP_HUGETLB
+    // reserved huge pages come aligned to their own size.
+    auto* reserved = mmap(nullptr, hugepage, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (reserved != MAP_FAILED) {
+      return reserved;
+    }
+#endif
+
+    // no reserved huge pages, so map twice the size, cut an aligned page out
+    // of the middle and ask for it to be backed transparently. if that isn't
+    // available either, we still have a perfectly good run of small pages.
+    auto* mapped = mmap(nullptr, 2 * hugepage, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+      return nullptr;
+    }
+
+    auto* lower = static_cast<std::byte*>(mapped);
+    auto* upper = lower + 2 * hugepage;
+    auto* aligned = reinterpret_cast<std::byte*>(
+        (reinterpret_cast<uintptr_t>(lower) + hugepage - 1) & ~(hugepage - 1));
+
+    if (aligned != lower) {
+      munmap(lower, aligned - lower);
+    }
+    if (aligned + hugepage != upper) {
+      munmap(aligned + hugepage, upper - (aligned + hugepage));
+    }
+
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, hugepage, MADV_HUGEPAGE);
+#endif
+    return aligned;
+  }
+
+  inline void allocator::unmap_huge(void* memory) {
+    munmap(memory, hugepage);
+  }
+
+  template <uint64_t S>
+  allocator::allocation<S>& allocator::slab_allocation() {
+    return static_cast<allocation<S>&>(_allocations);
+  }
+
+  template <class T>
+  allocator::allocation<slab<T>>& allocator::typed_allocation() {
+    static_assert(std::is_base_of_v<allocation<slab<T>>, allocations<slablist>>,
+        "type is too large for any slab of the allocator.");
+    static_assert(alignof(T) <= alignof(allocated<slab<T>>),
+        "type is more strictly aligned than its slab.");
+
+    auto& allocation = slab_allocation<slab<T>>();
+    if constexpr (!std::is_trivially_copyable_v<T>) {
+      // compaction moves objects around bytewise, which is only safe for types
+      // that would survive a memcpy.
+      allocation._relocatable.store(false, std::memory_order_relaxed);
+    }
+    return allocation;
+  }
+
+  template <uint64_t ...Sizes>
+  allocator::allocations<slabs<Sizes...>>::allocations(allocator* owner) :
+      allocation<Sizes>{owner}... {
+  }
+
+  template <uint64_t ...Sizes>
+  uint64_t allocator::allocations<slabs<Sizes...>>::compact() {
+    return (allocation<Sizes>::compact() + ...);
+  }
+
+  template <uint64_t ...Sizes>
+  void allocator::allocations<slabs<Sizes...>>::drain() {
+    (allocation<Sizes>::drain(), ...);
+  }
+
+  template <uint64_t ...Sizes>
+  void allocator::allocations<slabs<Sizes...>>::statistics(std::vector<statistic>& result) const {
+    (result.push_back(allocation<Sizes>::statistics()), ...);
+  }
+
+  template <uint64_t S>
+  allocator::allocation<S>::allocation(allocator* owner) :
+      _allocator{owner},
+      _pagesize{owner->pagesize()},
+      _bitmap{(_pagesize / sizeof(node) + 63) / 64},
+      _offset{(sizeof(page) + _bitmap * sizeof(uint64_t) + alignof(node) - 1) / alignof(node) * alignof(node)},
+      _capacity{(_pagesize - _offset) / sizeof(node)},
+      _free{},
+      _pages{},
+      _idle{},
+      _spare{nullptr},
+      _next{nullptr},
+      _end{nullptr},
+      _relocatable{true},
+      _remote{nullptr} {
+    static_assert(sizeof(page) + sizeof(uint64_t) + sizeof(node) <= smallpage, "slab does not fit in a page.");
+  }
+
+  template <uint64_t S>
+  allocator::allocation<S>::~allocation() {
+    // the free slots live inside the pages, so the tree has to let go of them
+    // before the pages are handed back.
+    _free.clear();
+    for (auto* pages : {&_pages, &_idle}) {
+      while (auto* popped = pages->pop_front()) {
+        popped->~page();
+        _allocator->unmap_page(popped);
+      }
+    }
+  }
+
+  template <uint64_t S>
+  allocated<S>* allocator::allocation<S>::acquire() {
+    if (_remote.load(std::memory_order_relaxed)) {
+      drain();
+    }
+    return take();
+  }
+
+  template <uint64_t S>
+  allocated<S>* allocator::allocation<S>::take() {
+    node* acquired;
+
+    if (auto* freed = _free.minimum()) {
+      // always reuse the lowest free slot, so that live objects pack towards
+      // the bottom of the pages and the top ones are left to drain.
+      _free.remove(*freed);
+      freed->~liberated();
+      acquired = reinterpret_cast<node*>(freed);
+    } else {
+      if (_next == _end) {
+        map();
+      }
+      acquired = _next++;
+    }
+
+    auto* owner = page_of(acquired);
+    ++owner->_used;
+    occupy(1);
+    owner->make_live(acquired - first(owner));
+    if (owner == _spare) {
+      _spare = nullptr;
+    }
+
+    return new (&acquired->_allocated) allocated<S>{};
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::release(allocated<S>* released) {
+    released->~allocated();
+    liberate(reinterpret_cast<node*>(released));
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::defer(allocated<S>* released) {
+    auto* deferred = reinterpret_cast<node*>(released);
+    released->~allocated();
+
+    // producers only ever push, and the owner only ever takes the whole
+    // stack, so there is no aba to worry about.
+    deferred->_chained = _remote.load(std::memory_order_relaxed);
+    while (!_remote.compare_exchange_weak(deferred->_chained, deferred,
+        std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::drain() {
+    auto* drained = _remote.exchange(nullptr, std::memory_order_acquire);
+    while (drained) {
+      auto* chained = drained->_chained;
+      liberate(drained);
+      drained = chained;
+    }
+  }
+
+  template <uint64_t S>
+  typename allocator::allocation<S>::node* allocator::allocation<S>::carve(uint64_t count) {
+    assert(count <= _capacity);
+    if (_remote.load(std::memory_order_relaxed)) {
+      drain();
+    }
+
+    // a run never straddles two pages. if it doesn't fit in what's left of the
+    // page being carved, the rest of that page is handed to the free tree and
+    // the run starts on another one. the spare page is empty, so it is pulled
+    // back out of the free tree and carved afresh before a new page is mapped.
+    if (static_cast<uint64_t>(_end - _next) < count) {
+      for (; _next != _end; ++_next) {
+        _free.insert(*new (&_next->_liberated) liberated<S>{});
+      }
+      if (_spare) {
+        for (auto* slot = first(_spare); slot != carved(_spare); ++slot) {
+          _free.remove(slot->_liberated);
+          slot->_liberated.~liberated();
+        }
+        _next = first(_spare);
+        _end = _next + _capacity;
+      } else {
+        map();
+      }
+    }
+
+    auto* carved = _next;
+    _next += count;
+
+    auto* owner = page_of(carved);
+    owner->_used += count;
+    occupy(count);
+    for (auto* slot = carved; slot != _next; ++slot) {
+      owner->make_live(slot - first(owner));
+    }
+    if (owner == _spare) {
+      _spare = nullptr;
+    }
+
+    return carved;
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::release_n(std::vector<allocated<S>*>& released) {
+    // going from the top down, anything that sits right below the carving
+    // point can be uncarved instead of being put in the free tree. a batch
+    // that came from create_n and hasn't been disturbed goes back that way
+    // in its entirety.
+    std::sort(released.begin(), released.end(), std::greater<>{});
+    for (auto* each : released) {
+      auto* freed = reinterpret_cast<node*>(each);
+      each->~allocated();
+
+      if (freed + 1 == _next) {
+        auto* owner = page_of(freed);
+        owner->make_free(freed - first(owner));
+        --_next;
+        occupy(-1);
+        if (--owner->_used == 0) {
+          vacate(owner);
+        }
+      } else {
+        liberate(freed);
+      }
+    }
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::defer_n(std::vector<allocated<S>*>& released) {
+    if (released.empty()) {
+      return;
+    }
+
+    // the batch is chained up privately and pushed onto the stack as a whole.
+    node* head = nullptr;
+    node* tail = nullptr;
+    for (auto* each : released) {
+      auto* deferred = reinterpret_cast<node*>(each);
+      each->~allocated();
+      if (tail) {
+        tail->_chained = deferred;
+      } else {
+        head = deferred;
+      }
+      tail = deferred;
+    }
+
+    tail->_chained = _remote.load(std::memory_order_relaxed);
+    while (!_remote.compare_exchange_weak(tail->_chained, head,
+        std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::liberate(node* freed) {
+    _free.insert(*new (&freed->_liberated) liberated<S>{});
+
+    auto* owner = page_of(freed);
+    owner->make_free(freed - first(owner));
+    occupy(-1);
+    if (--owner->_used == 0) {
+      vacate(owner);
+    }
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::vacate(page* vacated) {
+    // one empty page is kept around as a spare so that a single object
+    // bouncing across a page boundary doesn't fault the page in and out.
+    // past that, the higher of the two empty pages goes back to the os.
+    if (!_spare) {
+      _spare = vacated;
+    } else if (vacated < _spare) {
+      purge(_spare);
+      _spare = vacated;
+    } else {
+      purge(vacated);
+    }
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::map() {
+    // every slot has been carved out of the pages we have, so start carving a
+    // new one, preferring a page that was drained earlier over a fresh one.
+    auto* mapped = _idle.pop_front();
+    if (!mapped) {
+      auto* memory = _allocator->map_page();
+      mapped = new (memory) page{};
+      std::memset(static_cast<void*>(mapped + 1), 0, _bitmap * sizeof(uint64_t));
+    }
+    _pages.push_back(*mapped);
+    tally(_counters._pages, 1);
+
+    _next = first(mapped);
+    _end = _next + _capacity;
+  }
+
+  template <uint64_t S>
+  uint64_t allocator::allocation<S>::compact() {
+    if (!_relocatable.load(std::memory_order_relaxed)) {
+      return 0;
+    }
+
+    // rank the pages from sparsest to densest, and count the free slots
+    // they've got between them.
+    std::vector<page*> ranked;
+    uint64_t vacant = 0;
+    for (auto& mapped : _pages) {
+      ranked.push_back(&mapped);
+      vacant += (carved(&mapped) - first(&mapped)) - mapped._used;
+    }
+    std::sort(ranked.begin(), ranked.end(), [](page* lhs, page* rhs) {
+      return lhs->_used < rhs->_used;
+    });
+
+    // evacuate the sparsest pages for as long as the denser ones can take in
+    // their objects. a page that's being evacuated doesn't count towards the
+    // room that's left, so nothing ever moves twice.
+    auto evacuated = ranked.begin();
+    while (evacuated != ranked.end()) {
+      auto* source = *evacuated;
+      auto holes = (carved(source) - first(source)) - source->_used;
+      if (source->_used + holes > vacant) {
+        break;
+      }
+      vacant -= holes + source->_used;
+
+      for (auto* slot = first(source); slot != carved(source); ++slot) {
+        if (!source->is_live(slot - first(source))) {
+          _free.remove(slot->_liberated);
+          slot->_liberated.~liberated();
+        }
+      }
+      ++evacuated;
+    }
+
+    for (auto source = ranked.begin(); source != evacuated; ++source) {
+      for (auto* slot = first(*source); slot != carved(*source); ++slot) {
+        if ((*source)->is_live(slot - first(*source))) {
+          // the move hands every handle of the object over to the new slot,
+          // the payload itself just gets copied across. remote frees were
+          // taken in before the pages were ranked, and any that come in since
+          // are left queued: one taken in now could land in a page that's
+          // being evacuated, and then be handed out as a destination.
+          auto* moved = reinterpret_cast<node*>(take());
+          moved->_allocated.~allocated();
+          new (&moved->_allocated) allocated<S>{std::move(slot->_allocated)};
+          std::memcpy(&moved->_allocated._data, &slot->_allocated._data, sizeof(slot->_allocated._data));
+          slot->_allocated.~allocated();
+
+          (*source)->make_free(slot - first(*source));
+          --(*source)->_used;
+          occupy(-1);
+        }
+      }
+    }
+
+    uint64_t reclaimed = 0;
+    for (auto source = ranked.begin(); source != evacuated; ++source) {
+      if (*source == _spare) {
+        _spare = nullptr;
+      }
+      reclaimed += retire(*source);
+    }
+    return reclaimed;
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::purge(page* purged) {
+    for (auto* purging = first(purged); purging != carved(purged); ++purging) {
+      _free.remove(purging->_liberated);
+      purging->_liberated.~liberated();
+    }
+    retire(purged);
+  }
+
+  template <uint64_t S>
+  uint64_t allocator::allocation<S>::retire(page* retired) {
+    // the page being carved stops being carved.
+    if (_end == first(retired) + _capacity) {
+      _next = nullptr;
+      _end = nullptr;
+    }
+
+    _pages.remove(*retired);
+    tally(_counters._pages, -1);
+
+    // dropping part of a huge page would only break it up again, so those
+    // go back whole. within a reservation they stay put in any case.
+    if (_allocator->_paging == pagings::huge && !_allocator->_reservation._base) {
+      retired->~page();
+      unmap_huge(retired);
+      return _pagesize;
+    }
+
+    _idle.push_back(*retired);
+
+    // the header stays resident to keep the page on the idle list, everything
+    // past the os page that holds it is dropped.
+    static const auto ospage = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    if (ospage < _pagesize) {
+      madvise(reinterpret_cast<std::byte*>(retired) + ospage, _pagesize - ospage, MADV_DONTNEED);
+      return _pagesize - ospage;
+    }
+    return 0;
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::tally(std::atomic<uint64_t>& counter, int64_t delta) {
+    // a plain load and store is enough with a single writer, and it keeps
+    // the hot path free of locked instructions.
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+
+  template <uint64_t S>
+  void allocator::allocation<S>::occupy(int64_t delta) {
+    tally(_counters._used, delta);
+    auto used = _counters._used.load(std::memory_order_relaxed);
+    if (used > _counters._peak.load(std::memory_order_relaxed)) {
+      _counters._peak.store(used, std::memory_order_relaxed);
+    }
+  }
+
+  template <uint64_t S>
+  allocator::statistic allocator::allocation<S>::statistics() const {
+    statistic result;
+    result._size = S;
+    result._used = _counters._used.load(std::memory_order_relaxed);
+    result._pages = _counters._pages.load(std::memory_order_relaxed);
+    result._peak = _counters._peak.load(std::memory_order_relaxed);
+    result._created = _counters._created.load(std::memory_order_relaxed);
+    result._destroyed = _counters._destroyed.load(std::memory_order_relaxed);
+
+    result._bytes = result._used * S;
+    result._mapped = result._pages * _pagesize;
+    auto slots = result._pages * _capacity;
+    result._free = slots > result._used ? slots - result._used : 0;
+    return result;
+  }
+
+  template <uint64_t S>
+  allocator::page* allocator::allocation<S>::page_of(void* address) {
+    return reinterpret_cast<page*>(reinterpret_cast<uintptr_t>(address) & ~(_pagesize - 1));
+  }
+
+  template <uint64_t S>
+  typename allocator::allocation<S>::node* allocator::allocation<S>::first(page* owner) {
+    return reinterpret_cast<node*>(reinterpret_cast<std::byte*>(owner) + _offset);
+  }
+
+  template <uint64_t S>
+  typename allocator::allocation<S>::node* allocator::allocation<S>::carved(page* owner) {
+    // only the page being carved has slots that were never handed out.
+    auto* last = first(owner) + _capacity;
+    return _end == last ? _next : last;
+  }
 
-//  template <class T>
-//  allocator<T>::allocator(uint64_t min_capacity, uint8_t max_doublings) :
-//      _allocated{0},
-//      _capacity{min_capacity},
-//      _growth_increment{min_capacity},
-//      _shrink_threshold{min_capacity},
-//      _min_capacity{min_capacity},
-//      _lin_boundary{min_capacity * (2 << max_doublings)}
-//  {
-//    _data = static_cast<node*>(aligned_alloc(align, _capacity * size));
-//    assert(_data);
-//
-//    _next = 0;
-//    for (uint64_t index = 0; index < _capacity; index++) {
-//      _data[index].free = freenode{index};
-//      _free.insert(_data[index].free);
-//    }
-//  }
-//
-//  template <class T>
-//  uint64_t allocator<T>::allocated() const {
-//    return _allocated;
-//  }
-//
-//  template <class T>
-//  uint64_t allocator<T>::capacity() const {
-//    return _capacity;
-//  }
-//
-//  template <class T>
-//  uint64_t allocator<T>::growth_increment() const {
-//    return _growth_increment;
-//  }
-//
-//  template <class T>
-//  uint64_t allocator<T>::shrink_threshold() const {
-//    return _shrink_threshold;
-//  }
-//
-//  template <class T>
-//  allocator<T>::~allocator() {
-//    std::free(_data);
-//  }
-//
-//  template <class T>
-//  template <class ...Args>
-//  pointer<T> allocator<T>::create(Args&&... args) {
-//    if (++_allocated == _capacity) {
-//      auto old_capacity = _capacity;
-//      auto old_data = _data;
-//
-//      _capacity += _growth_increment;
-//      if (_capacity < _lin_boundary) {
-//        _growth_increment *= 2;
-//      }
-//      if (_allocated == 4 * _shrink_threshold) {
-//        _shrink_threshold *= 2;
-//      }
-//
-//      _data = static_cast<node*>(aligned_alloc(align, _capacity * size));
-//      assert(_data);
-//
-//      memcpy(_data, old_data, old_capacity * size);
-//      std::free(old_data);
-//
-//      _data[_free].next = old_capacity;
-//      _data[_free].prev = _capacity-1;
-//      for (uint64_t index = old_capacity; index < _capacity; index++) {
-//        if (index == _capacity - 1) {
-//          _data[index] = {index - 1, _free, nullptr};
-//        } else if (index == old_capacity) {
-//          _data[index] = {_free, index + 1, nullptr};
-//        } else {
-//          _data[index] = {index - 1, index + 1, nullptr};
-//        }
-//      }
-//    }
-//
-//    const auto created_index = _free;
-//    auto& created_node = _data[created_index];
-//
-//    const auto prev_index = created_node.prev;
-//    auto& prev_node = _data[prev_index];
-//
-//    const auto next_index = created_node.next;
-//    auto& next_node = _data[next_index];
-//
-//    prev_node.next = next_index;
-//    next_node.prev = prev_index;
-//
-//    _free = next_index;
-//    new (&created_node.data) T{std::forward<Args>(args)...};
-//
-//    return {this, created_index};
-//  }
-//
-//  template <class T>
-//  void allocator<T>::destroy(pointer<T>& destroyed) {
-//    if (--_allocated == _shrink_threshold) {
-//      if (_capacity > _min_capacity) {
-//        auto old_capacity = _capacity;
-//        auto old_data = _data;
-//
-//        if (_capacity < _lin_boundary) {
-//          _growth_increment /= 2;
-//        }
-//
-//        _capacity = _shrink_threshold * 2;
-//        if (_capacity < _min_capacity) {
-//          _capacity = _min_capacity;
-//        }
-//
-//        _shrink_threshold = _shrink_threshold / 2;
-//        if (_shrink_threshold < _min_capacity) {
-//          _shrink_threshold = _min_capacity;
-//        }
-//
-//        if (_capacity < old_capacity) {
-//          _data = static_cast<node *>(aligned_alloc(align, _capacity * size));
-//          assert(_data);
-//
-//          uint64_t new_index = 0;
-//          uint64_t old_index = 0;
-//          while (old_index < old_capacity) {
-//            auto& old_node = old_data[old_index];
-//            if (auto* pointer = old_node.created) {
-//              auto& new_node = _data[new_index];
-//              memcpy(&new_node, &old_node, size);
-//              while (pointer) {
-//                pointer->_index = new_index;
-//                pointer = pointer->_next;
-//              }
-//              ++new_index;
-//            }
-//            ++old_index;
-//          }
-//          std::free(old_data);
-//
-//          _free = new_index;
-//          for (uint64_t index = new_index; index < _capacity; index++) {
-//            if (index == _capacity - 1) {
-//              _data[index] = {index - 1, _free, nullptr};
-//            } else if (index == old_capacity) {
-//              _data[index] = {_free, index + 1, nullptr};
-//            } else {
-//              _data[index] = {index - 1, index + 1, nullptr};
-//            }
-//          }
-//        }
-//      }
-//    }
-//
-//    auto destroyed_index = destroyed._index;
-//    auto& destroyed_node = _data[destroyed_index];
-//
-//    auto next_index = _free;
-//    auto& next_node = _data[next_index];
-//
-//    auto prev_index = next_node.prev;
-//    auto& prev_node = _data[prev_index];
-//
-//    prev_node.next = destroyed_index;
-//    destroyed_node.prev = prev_index;
-//    next_node.prev = destroyed_index;
-//    destroyed_node.next = next_index;
-//
-//    auto* pointer  = destroyed_node.created;
-//    while (pointer) {
-//      pointer->_allocator = nullptr;
-//      pointer = pointer->_next;
-//    }
-//    destroyed_node.created = nullptr;
-//  }
-//
-//  template <class T>
-//  void allocator<T>::attach_pointer(pointer <T>& p) {
-//    auto& pointers = _data[p.index].pointers;
-//    pointers.push_back(p);
-//  }
-//
-//  template <class T>
-//  void allocator<T>::detach_pointer(pointer <T>& p) {
-//    auto& pointers = _data[p.index].pointers;
-//    if (pointers.front() == &p) {
-//      pointers.pop_front();
-//    } else {
-//      p.splice(p.next());
-//    }
-//  }
+} // inline namespace HATCH_SLABTAG
 }
 
 #endif // HATCH_ALLOCATOR_IMPL_HH
@@ -0,0 +1,121 @@
+#ifndef HATCH_BTREE_HH
+#define HATCH_BTREE_HH
+
+#include <hatch/core/btree_fwd.hh>
+#include <hatch/core/memory.hh>
+
+#include <hatch/utility/owning.hh>
+
+#include <vector> // std::vector
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  // a b+-tree holds its payloads by value, many to a node, with the keys of a
+  // node side by side so that a search within it is a single pass over one or
+  // two cache lines. the leaves are chained in order for scans. iterating it
+  // looks just like iterating a tree.
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  class btree final : public owner<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>> {
+  public:
+    friend class btree_iterator<T, KeyOf, Compare, Fanout>;
+
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
+
+  public:
+    explicit btree(allocator& allocator);
+    ~btree();
+
+    btree(btree&& moved) noexcept;
+    btree& operator=(btree&& moved) noexcept;
+
+    btree(const btree&) = delete;
+    btree& operator=(const btree&) = delete;
+
+    ////////////////
+    // Iterators. //
+    ////////////////
+
+  public:
+    btree_iterator<T, KeyOf, Compare, Fanout> begin();
+    const btree_iterator<T, KeyOf, Compare, Fanout> begin() const;
+
+    btree_iterator<T, KeyOf, Compare, Fanout> end();
+    const btree_iterator<T, KeyOf, Compare, Fanout> end() const;
+
+    template <class K>
+    btree_iterator<T, KeyOf, Compare, Fanout> find(const K& key);
+
+    template <class K>
+    const btree_iterator<T, KeyOf, Compare, Fanout> find(const K& key) const;
+
+    template <class K>
+    btree_iterator<T, KeyOf, Compare, Fanout> lower_bound(const K& key);
+
+    template <class K>
+    const btree_iterator<T, KeyOf, Compare, Fanout> lower_bound(const K& key) const;
+
+    template <class K>
+    btree_iterator<T, KeyOf, Compare, Fanout> upper_bound(const K& key);
+
+    template <class K>
+    const btree_iterator<T, KeyOf, Compare, Fanout> upper_bound(const K& key) const;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    allocator* _allocator;
+    btree_node<T, KeyOf, Compare, Fanout>* _root;
+    uint64_t _size;
+
+    // the nodes point straight at each other, which is safe because a node
+    // can't be copied bytewise and so is never moved by compaction. the
+    // handles that own them are kept off to the side.
+    std::vector<pointer<btree_node<T, KeyOf, Compare, Fanout>>> _nodes;
+
+    btree_node<T, KeyOf, Compare, Fanout>* make(bool leaf);
+    void destroy(btree_node<T, KeyOf, Compare, Fanout>* node);
+    void release(btree_node<T, KeyOf, Compare, Fanout>* node);
+
+    btree_iterator<T, KeyOf, Compare, Fanout> at(btree_node<T, KeyOf, Compare, Fanout>* leaf, uint64_t index);
+
+    btree_node<T, KeyOf, Compare, Fanout>* split(btree_node<T, KeyOf, Compare, Fanout>* node);
+    void rebalance(btree_node<T, KeyOf, Compare, Fanout>* node);
+    void merge(btree_node<T, KeyOf, Compare, Fanout>* head, uint64_t index);
+
+    //////////////////////////
+    // Structure: accessors //
+    //////////////////////////
+
+  public:
+    bool empty() const;
+    uint64_t size() const;
+
+    /////////////////////////
+    // Structure: mutators //
+    /////////////////////////
+
+  public:
+    btree_iterator<T, KeyOf, Compare, Fanout> insert(T value);
+
+    template <class K>
+    bool remove(const K& key);
+
+    void clear();
+  };
+
+} // namespace hatch
+
+#include <hatch/core/btree_node.hh>
+#include <hatch/core/btree_iterator.hh>
+
+#include <hatch/core/btree_impl.hh>
+#include <hatch/core/btree_node_impl.hh>
+#include <hatch/core/btree_iterator_impl.hh>
+
+#endif // HATCH_BTREE_HH
@@ -0,0 +1,23 @@
+#ifndef HATCH_BTREE_FWD_HH
+#define HATCH_BTREE_FWD_HH
+
+#include <hatch/utility/tree_fwd.hh>
+
+#include <functional> // std::less
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  template <class T, class KeyOf = identity, class Compare = std::less<>, uint64_t Fanout = 16>
+  class btree;
+
+  template <class T, class KeyOf = identity, class Compare = std::less<>, uint64_t Fanout = 16>
+  class btree_node;
+
+  template <class T, class KeyOf = identity, class Compare = std::less<>, uint64_t Fanout = 16>
+  class btree_iterator;
+
+} // namespace hatch
+
+#endif // HATCH_BTREE_FWD_HH
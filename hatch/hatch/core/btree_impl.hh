@@ -0,0 +1,422 @@
+#ifndef HATCH_BTREE_IMPL_HH
+#define HATCH_BTREE_IMPL_HH
+
+#ifndef HATCH_BTREE_HH
+#error "do not include btree_impl.hh directly. include btree.hh instead."
+#endif
+
+#include <utility> // std::move
+
+namespace hatch {
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree<T, KeyOf, Compare, Fanout>::btree(allocator& allocator) :
+      _allocator{&allocator},
+      _root{nullptr},
+      _size{0},
+      _nodes{} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree<T, KeyOf, Compare, Fanout>::~btree() {
+    clear();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree<T, KeyOf, Compare, Fanout>::btree(btree&& moved) noexcept :
+      owner<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>>::owner{std::move(moved)},
+      _allocator{moved._allocator},
+      _root{moved._root},
+      _size{moved._size},
+      _nodes{std::move(moved._nodes)} {
+    moved._root = nullptr;
+    moved._size = 0;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree<T, KeyOf, Compare, Fanout>& btree<T, KeyOf, Compare, Fanout>::operator=(btree&& moved) noexcept {
+    clear();
+    owner<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>>::operator=(std::move(moved));
+    _allocator = moved._allocator;
+    _root = moved._root;
+    _size = moved._size;
+    _nodes = std::move(moved._nodes);
+    moved._root = nullptr;
+    moved._size = 0;
+    return *this;
+  }
+
+  ////////////////
+  // Iterators. //
+  ////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::begin() {
+    auto* first = _root;
+    while (first && !first->_leaf) {
+      first = first->_children[0];
+    }
+    return at(first, 0);
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  const btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::begin() const {
+    return const_cast<btree<T, KeyOf, Compare, Fanout>&>(*this).begin();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::end() {
+    return btree_iterator<T, KeyOf, Compare, Fanout>{this, btree_iterator<T, KeyOf, Compare, Fanout>::_after, 0};
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  const btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::end() const {
+    return const_cast<btree<T, KeyOf, Compare, Fanout>&>(*this).end();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::find(const K& key) {
+    auto found = lower_bound(key);
+    if (found != end() && !btree_node<T, KeyOf, Compare, Fanout>::less(key, KeyOf{}(*found))) {
+      return found;
+    }
+    return end();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  const btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::find(const K& key) const {
+    return const_cast<btree<T, KeyOf, Compare, Fanout>&>(*this).find(key);
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::lower_bound(const K& key) {
+    // equal keys can sit on both sides of an equal separator, so the leftmost
+    // one is found by going left of it.
+    auto* current = _root;
+    while (current && !current->_leaf) {
+      current = current->_children[current->lower(key)];
+    }
+    return current ? at(current, current->lower(key)) : end();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  const btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::lower_bound(const K& key) const {
+    return const_cast<btree<T, KeyOf, Compare, Fanout>&>(*this).lower_bound(key);
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::upper_bound(const K& key) {
+    auto* current = _root;
+    while (current && !current->_leaf) {
+      current = current->_children[current->upper(key)];
+    }
+    return current ? at(current, current->upper(key)) : end();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  const btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::upper_bound(const K& key) const {
+    return const_cast<btree<T, KeyOf, Compare, Fanout>&>(*this).upper_bound(key);
+  }
+
+  ////////////////
+  // Structure. //
+  ////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_node<T, KeyOf, Compare, Fanout>* btree<T, KeyOf, Compare, Fanout>::make(bool leaf) {
+    _nodes.push_back(_allocator->template create<btree_node<T, KeyOf, Compare, Fanout>>(leaf));
+    auto* node = &*_nodes.back();
+    node->_slot = _nodes.size() - 1;
+    return node;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree<T, KeyOf, Compare, Fanout>::destroy(btree_node<T, KeyOf, Compare, Fanout>* node) {
+    // the last handle takes over the slot of the one that goes.
+    auto slot = node->_slot;
+    _allocator->destroy(_nodes[slot]);
+    if (slot + 1 < _nodes.size()) {
+      _nodes[slot] = std::move(_nodes.back());
+      _nodes[slot]->_slot = slot;
+    }
+    _nodes.pop_back();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree<T, KeyOf, Compare, Fanout>::release(btree_node<T, KeyOf, Compare, Fanout>* node) {
+    // the recursion only goes as deep as the tree, which is a handful of
+    // levels even for millions of keys.
+    if (!node->_leaf) {
+      for (auto index = 0lu; index <= node->_count; index++) {
+        release(node->_children[index]);
+      }
+    }
+    destroy(node);
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::at(btree_node<T, KeyOf, Compare, Fanout>* leaf, uint64_t index) {
+    // a slot just past the end of a leaf is the first slot of the next one.
+    if (leaf && index == leaf->_count) {
+      leaf = leaf->_next;
+      index = 0;
+    }
+    if (!leaf) {
+      return end();
+    }
+    return btree_iterator<T, KeyOf, Compare, Fanout>{this, leaf, index};
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_node<T, KeyOf, Compare, Fanout>* btree<T, KeyOf, Compare, Fanout>::split(btree_node<T, KeyOf, Compare, Fanout>* node) {
+    // the upper half of a full node moves into a new node just after it, and
+    // the key between the halves goes up to the head, which may have to split
+    // in turn. returns the new node.
+    auto* split = make(node->_leaf);
+    auto half = Fanout / 2;
+
+    typename btree_node<T, KeyOf, Compare, Fanout>::key_type separator;
+    if (node->_leaf) {
+      for (auto index = half; index < node->_count; index++) {
+        split->insert_entry(split->_count, node->_keys[index], std::move(node->value(index)));
+      }
+      while (node->_count > half) {
+        node->remove_entry(node->_count - 1);
+      }
+      separator = split->_keys[0];
+
+      split->_prev = node;
+      split->_next = node->_next;
+      if (auto* next = node->_next) {
+        next->_prev = split;
+      }
+      node->_next = split;
+    } else {
+      split->_children[0] = node->_children[half + 1];
+      split->_children[0]->_head = split;
+      for (auto index = half + 1; index < node->_count; index++) {
+        split->insert_child(split->_count, node->_keys[index], node->_children[index + 1]);
+      }
+      separator = node->_keys[half];
+      node->_count = half;
+    }
+
+    if (!node->_head) {
+      auto* root = make(false);
+      root->_children[0] = node;
+      node->_head = root;
+      _root = root;
+    } else if (node->_head->_count == Fanout) {
+      this->split(node->_head);
+    }
+
+    // splitting the head may have moved this node over to the new half.
+    auto* head = node->_head;
+    head->insert_child(head->index_of(node), std::move(separator), split);
+    return split;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree<T, KeyOf, Compare, Fanout>::rebalance(btree_node<T, KeyOf, Compare, Fanout>* node) {
+    while (auto* head = node->_head) {
+      if (node->_count >= node->minimum()) {
+        return;
+      }
+
+      auto index = head->index_of(node);
+      auto* prev = index > 0 ? head->_children[index - 1] : nullptr;
+      auto* next = index < head->_count ? head->_children[index + 1] : nullptr;
+
+      if (prev && prev->_count > prev->minimum()) {
+        // the sibling before has some to spare.
+        //
+        // -> move its last entry over through the head.
+        //
+        auto last = prev->_count - 1;
+        if (node->_leaf) {
+          node->insert_entry(0, prev->_keys[last], std::move(prev->value(last)));
+          prev->remove_entry(last);
+          head->_keys[index - 1] = node->_keys[0];
+        } else {
+          for (auto moved = node->_count; moved > 0; moved--) {
+            node->_keys[moved] = std::move(node->_keys[moved - 1]);
+          }
+          for (auto moved = node->_count + 1; moved > 0; moved--) {
+            node->_children[moved] = node->_children[moved - 1];
+          }
+          node->_keys[0] = std::move(head->_keys[index - 1]);
+          node->_children[0] = prev->_children[prev->_count];
+          node->_children[0]->_head = node;
+          node->_count++;
+          head->_keys[index - 1] = std::move(prev->_keys[last]);
+          prev->_count--;
+        }
+        return;
+      }
+
+      if (next && next->_count > next->minimum()) {
+        // the sibling after has some to spare.
+        //
+        // -> move its first entry over through the head.
+        //
+        if (node->_leaf) {
+          node->insert_entry(node->_count, next->_keys[0], std::move(next->value(0)));
+          next->remove_entry(0);
+          head->_keys[index] = next->_keys[0];
+        } else {
+          node->_keys[node->_count] = std::move(head->_keys[index]);
+          node->_children[node->_count + 1] = next->_children[0];
+          node->_children[node->_count + 1]->_head = node;
+          node->_count++;
+          head->_keys[index] = std::move(next->_keys[0]);
+          for (auto moved = 1lu; moved < next->_count; moved++) {
+            next->_keys[moved - 1] = std::move(next->_keys[moved]);
+          }
+          for (auto moved = 1lu; moved <= next->_count; moved++) {
+            next->_children[moved - 1] = next->_children[moved];
+          }
+          next->_count--;
+        }
+        return;
+      }
+
+      // neither sibling has any to spare.
+      //
+      // -> merge with one of them, which takes a key out of the head, and see
+      //    whether that leaves the head short.
+      //
+      merge(head, prev ? index - 1 : index);
+      node = head;
+    }
+
+    // the root may be left with nothing in it, in which case its only child,
+    // if it has one, takes over.
+    if (node->_count == 0) {
+      if (node->_leaf) {
+        _root = nullptr;
+      } else {
+        _root = node->_children[0];
+        _root->_head = nullptr;
+      }
+      destroy(node);
+    }
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree<T, KeyOf, Compare, Fanout>::merge(btree_node<T, KeyOf, Compare, Fanout>* head, uint64_t index) {
+    // everything in the child after the key at the index moves into the child
+    // before it.
+    auto* prev = head->_children[index];
+    auto* next = head->_children[index + 1];
+
+    if (prev->_leaf) {
+      for (auto moved = 0lu; moved < next->_count; moved++) {
+        prev->insert_entry(prev->_count, next->_keys[moved], std::move(next->value(moved)));
+      }
+      while (next->_count > 0) {
+        next->remove_entry(next->_count - 1);
+      }
+
+      prev->_next = next->_next;
+      if (auto* after = next->_next) {
+        after->_prev = prev;
+      }
+    } else {
+      prev->insert_child(prev->_count, std::move(head->_keys[index]), next->_children[0]);
+      for (auto moved = 0lu; moved < next->_count; moved++) {
+        prev->insert_child(prev->_count, std::move(next->_keys[moved]), next->_children[moved + 1]);
+      }
+      next->_count = 0;
+    }
+
+    head->remove_child(index);
+    destroy(next);
+  }
+
+  //////////////////////////
+  // Structure: accessors //
+  //////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  bool btree<T, KeyOf, Compare, Fanout>::empty() const {
+    return !_root;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  uint64_t btree<T, KeyOf, Compare, Fanout>::size() const {
+    return _size;
+  }
+
+  /////////////////////////
+  // Structure: mutators //
+  /////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout> btree<T, KeyOf, Compare, Fanout>::insert(T value) {
+    this->disown_all();
+
+    if (!_root) {
+      _root = make(true);
+    }
+
+    // equal keys go after the ones already there, as they do in a tree.
+    typename btree_node<T, KeyOf, Compare, Fanout>::key_type key = KeyOf{}(value);
+    auto* leaf = _root;
+    while (!leaf->_leaf) {
+      leaf = leaf->_children[leaf->upper(key)];
+    }
+
+    if (leaf->_count == Fanout) {
+      auto* split = this->split(leaf);
+      if (!btree_node<T, KeyOf, Compare, Fanout>::less(key, split->_keys[0])) {
+        leaf = split;
+      }
+    }
+
+    auto index = leaf->upper(key);
+    leaf->insert_entry(index, std::move(key), std::move(value));
+    _size++;
+    return btree_iterator<T, KeyOf, Compare, Fanout>{this, leaf, index};
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  bool btree<T, KeyOf, Compare, Fanout>::remove(const K& key) {
+    auto found = find(key);
+    if (found == end()) {
+      return false;
+    }
+
+    this->disown_all();
+
+    auto* leaf = found._node;
+    leaf->remove_entry(found._index);
+    _size--;
+    rebalance(leaf);
+    return true;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree<T, KeyOf, Compare, Fanout>::clear() {
+    this->disown_all();
+
+    if (_root) {
+      release(_root);
+    }
+    _root = nullptr;
+    _size = 0;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_BTREE_IMPL_HH
@@ -0,0 +1,79 @@
+#ifndef HATCH_BTREE_ITERATOR_HH
+#define HATCH_BTREE_ITERATOR_HH
+
+#ifndef HATCH_BTREE_HH
+#error "do not include btree_iterator.hh directly. include btree.hh instead."
+#endif
+
+#include <hatch/utility/owning.hh>
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  class btree_iterator final : public owned<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>> {
+  public:
+    friend class btree<T, KeyOf, Compare, Fanout>;
+
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
+
+  private:
+    explicit btree_iterator(btree<T, KeyOf, Compare, Fanout>* owner, btree_node<T, KeyOf, Compare, Fanout>* node, uint64_t index);
+
+  public:
+    btree_iterator();
+    ~btree_iterator();
+
+    btree_iterator(btree_iterator&& moved) noexcept;
+    btree_iterator& operator=(btree_iterator&& moved) noexcept;
+
+    btree_iterator(const btree_iterator& copied);
+    btree_iterator& operator=(const btree_iterator& copied);
+
+    //////////////////
+    // Comparisons. //
+    //////////////////
+
+  public:
+    operator bool() const;
+    bool operator==(const btree_iterator& compared) const;
+    bool operator!=(const btree_iterator& compared) const;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    mutable btree_node<T, KeyOf, Compare, Fanout>* _node;
+    mutable uint64_t _index;
+    static btree_node<T, KeyOf, Compare, Fanout>* _before;
+    static btree_node<T, KeyOf, Compare, Fanout>* _after;
+
+    /////////////////////////////////////
+    // Structure: get underlying data. //
+    /////////////////////////////////////
+
+  public:
+    T& operator*() const;
+    T* operator->() const;
+
+    ///////////////////////////////
+    // Structure: move iterator. //
+    ///////////////////////////////
+
+  public:
+    btree_iterator& operator++();
+    const btree_iterator& operator++() const;
+    const btree_iterator operator++(int) const;
+
+    btree_iterator& operator--();
+    const btree_iterator& operator--() const;
+    const btree_iterator operator--(int) const;
+  };
+
+} // namespace hatch
+
+#endif // HATCH_BTREE_ITERATOR_HH
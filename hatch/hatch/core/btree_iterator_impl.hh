@@ -0,0 +1,190 @@
+#ifndef HATCH_BTREE_ITERATOR_IMPL_HH
+#define HATCH_BTREE_ITERATOR_IMPL_HH
+
+#ifndef HATCH_BTREE_HH
+#error "do not include btree_iterator_impl.hh directly. include btree.hh instead."
+#endif
+
+namespace hatch {
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_node<T, KeyOf, Compare, Fanout>* btree_iterator<T, KeyOf, Compare, Fanout>::_before =
+      const_cast<btree_node<T, KeyOf, Compare, Fanout>*>(reinterpret_cast<const btree_node<T, KeyOf, Compare, Fanout>*>("btree_iterator::before"));
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_node<T, KeyOf, Compare, Fanout>* btree_iterator<T, KeyOf, Compare, Fanout>::_after =
+      const_cast<btree_node<T, KeyOf, Compare, Fanout>*>(reinterpret_cast<const btree_node<T, KeyOf, Compare, Fanout>*>("btree_iterator::after"));
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>::btree_iterator(btree<T, KeyOf, Compare, Fanout>* owner, btree_node<T, KeyOf, Compare, Fanout>* node, uint64_t index) :
+      owned<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>>::owned{owner},
+      _node{node},
+      _index{index} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>::btree_iterator() :
+      owned<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>>::owned{},
+      _node{nullptr},
+      _index{0} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>::~btree_iterator() {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>::btree_iterator(btree_iterator&& moved) noexcept :
+      owned<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>>::owned{std::move(moved)},
+      _node{moved._node},
+      _index{moved._index} {
+    moved._node = nullptr;
+    moved._index = 0;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>& btree_iterator<T, KeyOf, Compare, Fanout>::operator=(btree_iterator&& moved) noexcept {
+    owned<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>>::operator=(std::move(moved));
+    _node = moved._node;
+    _index = moved._index;
+    moved._node = nullptr;
+    moved._index = 0;
+    return *this;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>::btree_iterator(const btree_iterator& copied) :
+      owned<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>>::owned{copied},
+      _node{copied._node},
+      _index{copied._index} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>& btree_iterator<T, KeyOf, Compare, Fanout>::operator=(const btree_iterator& copied) {
+    owned<btree<T, KeyOf, Compare, Fanout>, btree_iterator<T, KeyOf, Compare, Fanout>>::operator=(copied);
+    _node = copied._node;
+    _index = copied._index;
+    return *this;
+  }
+
+  //////////////////
+  // Comparisons. //
+  //////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>::operator bool() const {
+    return this->_owner;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  bool btree_iterator<T, KeyOf, Compare, Fanout>::operator==(const btree_iterator& compared) const {
+    return this->_owner == compared._owner && _node == compared._node && _index == compared._index;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  bool btree_iterator<T, KeyOf, Compare, Fanout>::operator!=(const btree_iterator& compared) const {
+    return !operator==(compared);
+  }
+
+  /////////////////////////////////////
+  // Structure: get underlying data. //
+  /////////////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  T& btree_iterator<T, KeyOf, Compare, Fanout>::operator*() const {
+    return _node->value(_index);
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  T* btree_iterator<T, KeyOf, Compare, Fanout>::operator->() const {
+    return &_node->value(_index);
+  }
+
+  ///////////////////////////////
+  // Structure: move iterator. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>& btree_iterator<T, KeyOf, Compare, Fanout>::operator++() {
+    if (auto* tree = this->_owner) {
+      if (_node == _before) {
+        *this = tree->begin();
+      } else if (_node != _after) {
+        // within a leaf it's just the next slot over, and past its end it's
+        // the first slot of the next leaf in the chain.
+        if (_index + 1 < _node->_count) {
+          _index++;
+        } else if (auto* next = _node->_next) {
+          _node = next;
+          _index = 0;
+        } else {
+          _node = _after;
+          _index = 0;
+        }
+      }
+    }
+    return *this;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  const btree_iterator<T, KeyOf, Compare, Fanout>& btree_iterator<T, KeyOf, Compare, Fanout>::operator++() const {
+    return const_cast<btree_iterator<T, KeyOf, Compare, Fanout>*>(this)->operator++();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  const btree_iterator<T, KeyOf, Compare, Fanout> btree_iterator<T, KeyOf, Compare, Fanout>::operator++(int) const {
+    auto* const node = _node;
+    auto const index = _index;
+    this->operator++();
+    return btree_iterator<T, KeyOf, Compare, Fanout>{this->_owner, node, index};
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_iterator<T, KeyOf, Compare, Fanout>& btree_iterator<T, KeyOf, Compare, Fanout>::operator--() {
+    if (auto* tree = this->_owner) {
+      if (_node == _after) {
+        auto* last = tree->_root;
+        while (last && !last->_leaf) {
+          last = last->_children[last->_count];
+        }
+        if (last) {
+          _node = last;
+          _index = last->_count - 1;
+        } else {
+          _node = _before;
+        }
+      } else if (_node != _before) {
+        if (_index > 0) {
+          _index--;
+        } else if (auto* prev = _node->_prev) {
+          _node = prev;
+          _index = prev->_count - 1;
+        } else {
+          _node = _before;
+          _index = 0;
+        }
+      }
+    }
+    return *this;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  const btree_iterator<T, KeyOf, Compare, Fanout>& btree_iterator<T, KeyOf, Compare, Fanout>::operator--() const {
+    return const_cast<btree_iterator<T, KeyOf, Compare, Fanout>*>(this)->operator--();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  const btree_iterator<T, KeyOf, Compare, Fanout> btree_iterator<T, KeyOf, Compare, Fanout>::operator--(int) const {
+    auto* const node = _node;
+    auto const index = _index;
+    this->operator--();
+    return btree_iterator<T, KeyOf, Compare, Fanout>{this->_owner, node, index};
+  }
+
+} // namespace hatch
+
+#endif // HATCH_BTREE_ITERATOR_IMPL_HH
@@ -0,0 +1,94 @@
+#ifndef HATCH_BTREE_NODE_HH
+#define HATCH_BTREE_NODE_HH
+
+#ifndef HATCH_BTREE_HH
+#error "do not include btree_node.hh directly. include btree.hh instead."
+#endif
+
+#include <type_traits> // std::aligned_storage_t, std::decay_t, std::invoke_result_t
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  class btree_node {
+  public:
+    friend class btree<T, KeyOf, Compare, Fanout>;
+    friend class btree_iterator<T, KeyOf, Compare, Fanout>;
+
+    static_assert(Fanout >= 4, "a b+-tree node needs room for at least four keys.");
+
+    using key_type = std::decay_t<std::invoke_result_t<KeyOf, const T&>>;
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    explicit btree_node(bool leaf);
+    ~btree_node();
+
+    btree_node(btree_node&& moved) = delete;
+    btree_node& operator=(btree_node&& moved) = delete;
+
+    btree_node(const btree_node&) = delete;
+    btree_node& operator=(const btree_node&) = delete;
+
+    ///////////
+    // Keys. //
+    ///////////
+
+  private:
+    template <class K>
+    uint64_t lower(const K& key) const;
+
+    template <class K>
+    uint64_t upper(const K& key) const;
+
+    template <class L, class R>
+    static bool less(const L& lhs, const R& rhs);
+
+    //////////////
+    // Entries. //
+    //////////////
+
+  private:
+    T& value(uint64_t index);
+
+    // a leaf pairs every key with a payload; an inner node has one more child
+    // than it has keys, and every key is no greater than anything to its right.
+    void insert_entry(uint64_t index, key_type key, T&& value);
+    void remove_entry(uint64_t index);
+
+    void insert_child(uint64_t index, key_type key, btree_node* child);
+    void remove_child(uint64_t index);
+    uint64_t index_of(const btree_node* child) const;
+
+    uint64_t minimum() const;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    bool _leaf;
+    uint64_t _count;
+    btree_node* _head;
+    btree_node* _prev;
+    btree_node* _next;
+
+    key_type _keys[Fanout];
+
+    union {
+      btree_node* _children[Fanout + 1];
+      std::aligned_storage_t<sizeof(T), alignof(T)> _values[Fanout];
+    };
+
+    // where the tree keeps the handle that owns this node.
+    uint64_t _slot;
+  };
+
+} // namespace hatch
+
+#endif // HATCH_BTREE_NODE_HH
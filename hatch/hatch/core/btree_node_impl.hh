@@ -0,0 +1,142 @@
+#ifndef HATCH_BTREE_NODE_IMPL_HH
+#define HATCH_BTREE_NODE_IMPL_HH
+
+#ifndef HATCH_BTREE_HH
+#error "do not include btree_node_impl.hh directly. include btree.hh instead."
+#endif
+
+#include <new> // std::launder
+#include <utility> // std::move
+
+namespace hatch {
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_node<T, KeyOf, Compare, Fanout>::btree_node(bool leaf) :
+      _leaf{leaf},
+      _count{0},
+      _head{nullptr},
+      _prev{nullptr},
+      _next{nullptr},
+      _keys{},
+      _children{},
+      _slot{0} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  btree_node<T, KeyOf, Compare, Fanout>::~btree_node() {
+    if (_leaf) {
+      for (auto index = 0lu; index < _count; index++) {
+        value(index).~T();
+      }
+    }
+  }
+
+  ///////////
+  // Keys. //
+  ///////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  uint64_t btree_node<T, KeyOf, Compare, Fanout>::lower(const K& key) const {
+    // counting instead of stopping at the first match has no branch to
+    // mispredict, and for plain keys the compiler turns it into vector code.
+    auto count = 0lu;
+    for (auto index = 0lu; index < _count; index++) {
+      count += less(_keys[index], key) ? 1 : 0;
+    }
+    return count;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class K>
+  uint64_t btree_node<T, KeyOf, Compare, Fanout>::upper(const K& key) const {
+    auto count = 0lu;
+    for (auto index = 0lu; index < _count; index++) {
+      count += less(key, _keys[index]) ? 0 : 1;
+    }
+    return count;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  template <class L, class R>
+  bool btree_node<T, KeyOf, Compare, Fanout>::less(const L& lhs, const R& rhs) {
+    return Compare{}(lhs, rhs);
+  }
+
+  //////////////
+  // Entries. //
+  //////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  T& btree_node<T, KeyOf, Compare, Fanout>::value(uint64_t index) {
+    return *std::launder(reinterpret_cast<T*>(&_values[index]));
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree_node<T, KeyOf, Compare, Fanout>::insert_entry(uint64_t index, key_type key, T&& value) {
+    for (auto moved = _count; moved > index; moved--) {
+      new (&_values[moved]) T{std::move(this->value(moved - 1))};
+      this->value(moved - 1).~T();
+      _keys[moved] = std::move(_keys[moved - 1]);
+    }
+    new (&_values[index]) T{std::move(value)};
+    _keys[index] = std::move(key);
+    _count++;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree_node<T, KeyOf, Compare, Fanout>::remove_entry(uint64_t index) {
+    value(index).~T();
+    for (auto moved = index + 1; moved < _count; moved++) {
+      new (&_values[moved - 1]) T{std::move(value(moved))};
+      value(moved).~T();
+      _keys[moved - 1] = std::move(_keys[moved]);
+    }
+    _count--;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree_node<T, KeyOf, Compare, Fanout>::insert_child(uint64_t index, key_type key, btree_node* child) {
+    // the key goes in at the index, and the child right after it.
+    for (auto moved = _count; moved > index; moved--) {
+      _keys[moved] = std::move(_keys[moved - 1]);
+      _children[moved + 1] = _children[moved];
+    }
+    _keys[index] = std::move(key);
+    _children[index + 1] = child;
+    child->_head = this;
+    _count++;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  void btree_node<T, KeyOf, Compare, Fanout>::remove_child(uint64_t index) {
+    for (auto moved = index + 1; moved < _count; moved++) {
+      _keys[moved - 1] = std::move(_keys[moved]);
+      _children[moved] = _children[moved + 1];
+    }
+    _count--;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  uint64_t btree_node<T, KeyOf, Compare, Fanout>::index_of(const btree_node* child) const {
+    auto index = 0lu;
+    while (_children[index] != child) {
+      index++;
+    }
+    return index;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Fanout>
+  uint64_t btree_node<T, KeyOf, Compare, Fanout>::minimum() const {
+    // splitting a full node leaves at least this much on both sides, and two
+    // nodes that fall under it always fit into one.
+    return _leaf ? Fanout / 2 : (Fanout - 1) / 2;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_BTREE_NODE_IMPL_HH
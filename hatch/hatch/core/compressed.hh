@@ -0,0 +1,66 @@
+#ifndef HATCH_COMPRESSED_HH
+#define HATCH_COMPRESSED_HH
+
+#ifndef HATCH_MEMORY_HH
+#error "do not include compressed.hh directly. include memory.hh instead."
+#endif
+
+#include <hatch/core/pointer.hh>
+#include <hatch/utility/indexed.hh>
+#include <hatch/utility/integral.hh>
+
+#include <cstddef> // std::byte
+
+namespace hatch {
+inline namespace HATCH_SLABTAG {
+
+  // a reference to an object of an allocator with a reach, stored as its
+  // distance from the allocator's base in units of eight bytes. 32 bits cover
+  // 32 GiB of reach, 16 bits cover 512 KiB.
+  //
+  // unlike pointer, it takes no part in the ownership of the object: it has to
+  // be let go of before the object is destroyed, just like a T* would. the
+  // base comes from the thread's context, which has to be set up for as long
+  // as references are made or followed.
+  template <class T, widths Width>
+  class compressed {
+  private:
+    static constexpr nosignint<Width> granule = 8;
+    using index = indexed<std::byte, Width, granule>;
+
+  public:
+    using context = typename index::context;
+
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
+
+  public:
+    compressed();
+    explicit compressed(pointer<T>& ptr);
+    ~compressed();
+
+    compressed(compressed&& moved) noexcept;
+    compressed& operator=(compressed&& moved) noexcept;
+
+    compressed(const compressed& copied);
+    compressed& operator=(const compressed& copied);
+
+    ////////////////
+    // Interface. //
+    ////////////////
+
+  public:
+    T* operator->();
+    T& operator*();
+
+    explicit operator bool() const;
+
+  private:
+    index _index;
+  };
+
+} // inline namespace HATCH_SLABTAG
+} // end namespace hatch
+
+#endif // HATCH_COMPRESSED_HH
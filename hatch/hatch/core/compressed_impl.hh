@@ -0,0 +1,88 @@
+#ifndef HATCH_COMPRESSED_IMPL_HH
+#define HATCH_COMPRESSED_IMPL_HH
+
+#ifndef HATCH_MEMORY_HH
+#error "do not include compressed_impl.hh directly. include memory.hh instead."
+#endif
+
+#include <utility> // std::move
+
+#include <cassert> // assert
+
+namespace hatch {
+inline namespace HATCH_SLABTAG {
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  template <class T, widths Width>
+  compressed<T, Width>::compressed() :
+      _index{} {
+  }
+
+  template <class T, widths Width>
+  compressed<T, Width>::compressed(pointer<T>& ptr) :
+      _index{} {
+    if (ptr) {
+      auto* allocator = ptr._allocator;
+      auto* address = reinterpret_cast<std::byte*>(&*ptr);
+      assert(allocator->base() && address >= allocator->base());
+      assert(uint64_t(address - allocator->base()) / granule < nosignmax<Width>);
+
+      // compaction would move the object out from under us, and there's no
+      // way of telling a compressed reference about it.
+      allocator->template typed_allocation<T>()._relocatable.store(false, std::memory_order_relaxed);
+      _index = address;
+    }
+  }
+
+  template <class T, widths Width>
+  compressed<T, Width>::~compressed() {
+  }
+
+  template <class T, widths Width>
+  compressed<T, Width>::compressed(compressed&& moved) noexcept :
+      _index{std::move(moved._index)} {
+  }
+
+  template <class T, widths Width>
+  compressed<T, Width>& compressed<T, Width>::operator=(compressed&& moved) noexcept {
+    _index = std::move(moved._index);
+    return *this;
+  }
+
+  template <class T, widths Width>
+  compressed<T, Width>::compressed(const compressed& copied) :
+      _index{copied._index} {
+  }
+
+  template <class T, widths Width>
+  compressed<T, Width>& compressed<T, Width>::operator=(const compressed& copied) {
+    _index = copied._index;
+    return *this;
+  }
+
+  ////////////////
+  // Interface. //
+  ////////////////
+
+  template <class T, widths Width>
+  T* compressed<T, Width>::operator->() {
+    return reinterpret_cast<T*>(&*_index);
+  }
+
+  template <class T, widths Width>
+  T& compressed<T, Width>::operator*() {
+    return *reinterpret_cast<T*>(&*_index);
+  }
+
+  template <class T, widths Width>
+  compressed<T, Width>::operator bool() const {
+    return _index;
+  }
+
+} // inline namespace HATCH_SLABTAG
+} // end namespace hatch
+
+#endif // HATCH_COMPRESSED_IMPL_HH
@@ -0,0 +1,108 @@
+#ifndef HATCH_FLAT_HASH_HH
+#define HATCH_FLAT_HASH_HH
+
+#include <hatch/core/flat_hash_fwd.hh>
+#include <hatch/core/memory.hh>
+
+#include <utility> // std::pair
+#include <vector> // std::vector
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  // an open-addressing hash table that holds its payloads by value. the slots
+  // come in groups of sixteen, each with a byte of control per slot that says
+  // whether it's empty, deleted, or full, and if full, seven more bits of its
+  // hash. a probe checks a whole group's controls at once, and only compares
+  // keys where those seven bits match.
+  //
+  // the groups are allocated one by one, and a probe that finds no room in
+  // one moves on to another, so the table never needs one big array. each
+  // group has as many slots as fill its slab class best, which isn't always
+  // sixteen.
+  template <class T, class KeyOf, class Hash, class Equal>
+  class flat_hash final {
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
+
+  public:
+    explicit flat_hash(allocator& allocator);
+    ~flat_hash();
+
+    flat_hash(flat_hash&& moved) noexcept;
+    flat_hash& operator=(flat_hash&& moved) noexcept;
+
+    flat_hash(const flat_hash&) = delete;
+    flat_hash& operator=(const flat_hash&) = delete;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    allocator* _allocator;
+    uint64_t _size;
+
+    // how many more slots can be filled, counting deleted ones as filled,
+    // before the table has to grow to keep its probes short.
+    uint64_t _left;
+
+    // the groups are never moved by compaction, so a handle always leads
+    // straight to its group, and the handles are all the table keeps. they
+    // only ever dereference, which const lookups need to do as well.
+    mutable std::vector<pointer<flat_hash_group<T, KeyOf, Hash, Equal>>> _groups;
+
+    template <class K>
+    static uint64_t hash(const K& key);
+
+    template <class K>
+    std::pair<flat_hash_group<T, KeyOf, Hash, Equal>*, uint64_t> locate(const K& key, uint64_t hash) const;
+
+    std::pair<flat_hash_group<T, KeyOf, Hash, Equal>*, uint64_t> vacancy(uint64_t hash) const;
+
+    void resize(uint64_t groups);
+    void release();
+
+    //////////////////////////
+    // Structure: accessors //
+    //////////////////////////
+
+  public:
+    bool empty() const;
+    uint64_t size() const;
+    uint64_t capacity() const;
+
+    template <class K>
+    T* find(const K& key);
+
+    template <class K>
+    const T* find(const K& key) const;
+
+    template <class Visit>
+    void visit(Visit visit) const;
+
+    /////////////////////////
+    // Structure: mutators //
+    /////////////////////////
+
+  public:
+    // keys are unique. the entry that has the key afterwards comes back, along
+    // with whether it's the one that was just put in.
+    std::pair<T*, bool> insert(T value);
+
+    template <class K>
+    bool remove(const K& key);
+
+    void clear();
+  };
+
+} // namespace hatch
+
+#include <hatch/core/flat_hash_group.hh>
+
+#include <hatch/core/flat_hash_impl.hh>
+#include <hatch/core/flat_hash_group_impl.hh>
+
+#endif // HATCH_FLAT_HASH_HH
@@ -0,0 +1,18 @@
+#ifndef HATCH_FLAT_HASH_FWD_HH
+#define HATCH_FLAT_HASH_FWD_HH
+
+#include <hatch/utility/hash_table_fwd.hh>
+
+#include <functional> // std::equal_to
+
+namespace hatch {
+
+  template <class T, class KeyOf = identity, class Hash = hashed, class Equal = std::equal_to<>>
+  class flat_hash;
+
+  template <class T, class KeyOf = identity, class Hash = hashed, class Equal = std::equal_to<>>
+  class flat_hash_group;
+
+} // namespace hatch
+
+#endif // HATCH_FLAT_HASH_FWD_HH
@@ -0,0 +1,95 @@
+#ifndef HATCH_FLAT_HASH_GROUP_HH
+#define HATCH_FLAT_HASH_GROUP_HH
+
+#ifndef HATCH_FLAT_HASH_HH
+#error "do not include flat_hash_group.hh directly. include flat_hash.hh instead."
+#endif
+
+#include <type_traits> // std::aligned_storage_t
+#include <utility> // std::integer_sequence, std::make_integer_sequence
+
+#include <cstdint> // int8_t, uint32_t, uint64_t
+
+namespace hatch {
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  class flat_hash_group {
+  public:
+    friend class flat_hash<T, KeyOf, Hash, Equal>;
+
+    // the controls are always checked sixteen at a time, but a group can have
+    // fewer slots than that. it takes however many leave the least of its slab
+    // unused, since a full sixteen usually lands just past a class boundary.
+    static constexpr uint64_t lanes = 16;
+
+  private:
+    template <uint64_t Width>
+    class layout {
+    public:
+      alignas(16) int8_t _controls[lanes];
+      std::aligned_storage_t<sizeof(T), alignof(T)> _values[Width];
+    };
+
+    template <uint64_t ...Widths>
+    static constexpr uint64_t fit(std::integer_sequence<uint64_t, Widths...>);
+
+  public:
+    static constexpr uint64_t width = fit(std::make_integer_sequence<uint64_t, lanes>{});
+
+    // a full slot's control is the top seven bits of its hash, so it never has
+    // the sign bit set, and these always do. lanes past the last slot are
+    // unused, which is neither vacant nor a possible match.
+    static constexpr int8_t empty = -128;
+    static constexpr int8_t deleted = -2;
+    static constexpr int8_t unused = -1;
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    flat_hash_group();
+    ~flat_hash_group();
+
+    flat_hash_group(flat_hash_group&& moved) = delete;
+    flat_hash_group& operator=(flat_hash_group&& moved) = delete;
+
+    flat_hash_group(const flat_hash_group&) = delete;
+    flat_hash_group& operator=(const flat_hash_group&) = delete;
+
+    ///////////////
+    // Controls. //
+    ///////////////
+
+  private:
+    // each of these is a mask with a bit for every slot whose control fits.
+    uint32_t matching(int8_t control) const;
+    uint32_t empties() const;
+    uint32_t vacancies() const;
+    uint32_t fulls() const;
+
+    static uint64_t first(uint32_t mask);
+
+    //////////////
+    // Entries. //
+    //////////////
+
+  private:
+    T& value(uint64_t index);
+    decltype(auto) key(uint64_t index);
+
+    void fill(uint64_t index, int8_t control, T&& value);
+    void erase(uint64_t index);
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    alignas(16) int8_t _controls[lanes];
+    std::aligned_storage_t<sizeof(T), alignof(T)> _values[width];
+  };
+
+} // namespace hatch
+
+#endif // HATCH_FLAT_HASH_GROUP_HH
@@ -0,0 +1,131 @@
+#ifndef HATCH_FLAT_HASH_GROUP_IMPL_HH
+#define HATCH_FLAT_HASH_GROUP_IMPL_HH
+
+#ifndef HATCH_FLAT_HASH_HH
+#error "do not include flat_hash_group_impl.hh directly. include flat_hash.hh instead."
+#endif
+
+#include <new> // std::launder
+#include <utility> // std::move
+
+#include <cstring> // std::memset
+
+#if defined(__SSE2__)
+#include <emmintrin.h> // _mm_cmpeq_epi8, _mm_cmplt_epi8, _mm_load_si128, _mm_movemask_epi8, _mm_set1_epi8
+#endif
+
+namespace hatch {
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  flat_hash_group<T, KeyOf, Hash, Equal>::flat_hash_group() {
+    std::memset(_controls, empty, width);
+    std::memset(_controls + width, unused, lanes - width);
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  flat_hash_group<T, KeyOf, Hash, Equal>::~flat_hash_group() {
+    for (auto mask = fulls(); mask; mask &= mask - 1) {
+      value(first(mask)).~T();
+    }
+  }
+
+  ///////////////
+  // Controls. //
+  ///////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <uint64_t ...Widths>
+  constexpr uint64_t flat_hash_group<T, KeyOf, Hash, Equal>::fit(std::integer_sequence<uint64_t, Widths...>) {
+    // the most slots per byte of slab, and the most slots among those.
+    uint64_t widths[] = {(Widths + 1)...};
+    uint64_t slabs[] = {slab<layout<Widths + 1>>...};
+    auto best = 0lu;
+    for (auto index = 1lu; index < sizeof...(Widths); index++) {
+      if (widths[index] * slabs[best] >= widths[best] * slabs[index]) {
+        best = index;
+      }
+    }
+    return widths[best];
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint32_t flat_hash_group<T, KeyOf, Hash, Equal>::matching(int8_t control) const {
+#if defined(__SSE2__)
+    auto controls = _mm_load_si128(reinterpret_cast<const __m128i*>(_controls));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(control)));
+#else
+    auto mask = 0u;
+    for (auto index = 0lu; index < lanes; index++) {
+      mask |= (_controls[index] == control ? 1u : 0u) << index;
+    }
+    return mask;
+#endif
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint32_t flat_hash_group<T, KeyOf, Hash, Equal>::empties() const {
+    return matching(empty);
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint32_t flat_hash_group<T, KeyOf, Hash, Equal>::vacancies() const {
+    // empty and deleted are the only controls below -1.
+#if defined(__SSE2__)
+    auto controls = _mm_load_si128(reinterpret_cast<const __m128i*>(_controls));
+    return _mm_movemask_epi8(_mm_cmplt_epi8(controls, _mm_set1_epi8(-1)));
+#else
+    auto mask = 0u;
+    for (auto index = 0lu; index < lanes; index++) {
+      mask |= (_controls[index] < -1 ? 1u : 0u) << index;
+    }
+    return mask;
+#endif
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint32_t flat_hash_group<T, KeyOf, Hash, Equal>::fulls() const {
+    // the unused lanes aren't vacant either, so they have to be masked off.
+    return ~vacancies() & ((1u << width) - 1);
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint64_t flat_hash_group<T, KeyOf, Hash, Equal>::first(uint32_t mask) {
+    return __builtin_ctz(mask);
+  }
+
+  //////////////
+  // Entries. //
+  //////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  T& flat_hash_group<T, KeyOf, Hash, Equal>::value(uint64_t index) {
+    return *std::launder(reinterpret_cast<T*>(&_values[index]));
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  decltype(auto) flat_hash_group<T, KeyOf, Hash, Equal>::key(uint64_t index) {
+    return KeyOf{}(static_cast<const T&>(value(index)));
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void flat_hash_group<T, KeyOf, Hash, Equal>::fill(uint64_t index, int8_t control, T&& value) {
+    new (&_values[index]) T{std::move(value)};
+    _controls[index] = control;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void flat_hash_group<T, KeyOf, Hash, Equal>::erase(uint64_t index) {
+    value(index).~T();
+
+    // a probe only moves past a group that has no empty slot, so if there's
+    // one here already, nothing can be looking beyond this group for its key.
+    _controls[index] = empties() ? empty : deleted;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_FLAT_HASH_GROUP_IMPL_HH
@@ -0,0 +1,234 @@
+#ifndef HATCH_FLAT_HASH_IMPL_HH
+#define HATCH_FLAT_HASH_IMPL_HH
+
+#ifndef HATCH_FLAT_HASH_HH
+#error "do not include flat_hash_impl.hh directly. include flat_hash.hh instead."
+#endif
+
+#include <utility> // std::move, std::swap
+
+namespace hatch {
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  flat_hash<T, KeyOf, Hash, Equal>::flat_hash(allocator& allocator) :
+      _allocator{&allocator},
+      _size{0},
+      _left{0},
+      _groups{} {
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  flat_hash<T, KeyOf, Hash, Equal>::~flat_hash() {
+    clear();
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  flat_hash<T, KeyOf, Hash, Equal>::flat_hash(flat_hash&& moved) noexcept :
+      _allocator{moved._allocator},
+      _size{moved._size},
+      _left{moved._left},
+      _groups{std::move(moved._groups)} {
+    moved._size = 0;
+    moved._left = 0;
+    moved._groups.clear();
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  flat_hash<T, KeyOf, Hash, Equal>& flat_hash<T, KeyOf, Hash, Equal>::operator=(flat_hash&& moved) noexcept {
+    if (this != &moved) {
+      clear();
+      _allocator = moved._allocator;
+      _size = moved._size;
+      _left = moved._left;
+      _groups = std::move(moved._groups);
+      moved._size = 0;
+      moved._left = 0;
+      moved._groups.clear();
+    }
+    return *this;
+  }
+
+  ////////////////
+  // Structure. //
+  ////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class K>
+  uint64_t flat_hash<T, KeyOf, Hash, Equal>::hash(const K& key) {
+    // the top seven bits become the control, and the bottom ones pick the
+    // first group, so the multiply's good high bits are folded down as well.
+    auto hash = Hash{}(key) * 0x9e3779b97f4a7c15lu;
+    return hash ^ (hash >> 32);
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class K>
+  std::pair<flat_hash_group<T, KeyOf, Hash, Equal>*, uint64_t> flat_hash<T, KeyOf, Hash, Equal>::locate(const K& key, uint64_t hash) const {
+    if (_groups.empty()) {
+      return {nullptr, 0};
+    }
+
+    // the strides grow by one each time, which visits every group once when
+    // there are a power of two of them.
+    auto control = static_cast<int8_t>(hash >> 57);
+    auto mask = _groups.size() - 1;
+    auto position = hash & mask;
+    for (auto stride = 1lu; stride <= _groups.size(); stride++) {
+      auto* group = &*_groups[position];
+      for (auto matches = group->matching(control); matches; matches &= matches - 1) {
+        auto index = group->first(matches);
+        if (Equal{}(group->key(index), key)) {
+          return {group, index};
+        }
+      }
+      if (group->empties()) {
+        break;
+      }
+      position = (position + stride) & mask;
+    }
+    return {nullptr, 0};
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  std::pair<flat_hash_group<T, KeyOf, Hash, Equal>*, uint64_t> flat_hash<T, KeyOf, Hash, Equal>::vacancy(uint64_t hash) const {
+    // there's always one somewhere, since the table grows long before it's
+    // full.
+    auto mask = _groups.size() - 1;
+    auto position = hash & mask;
+    for (auto stride = 1lu;; stride++) {
+      auto* group = &*_groups[position];
+      if (auto vacancies = group->vacancies()) {
+        return {group, group->first(vacancies)};
+      }
+      position = (position + stride) & mask;
+    }
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void flat_hash<T, KeyOf, Hash, Equal>::resize(uint64_t groups) {
+    auto handles = _allocator->template create_n<flat_hash_group<T, KeyOf, Hash, Equal>>(groups);
+    std::swap(_groups, handles);
+
+    // the old groups destroy whatever's left in their slots once they're
+    // released, so the values only have to be moved out, not destroyed.
+    for (auto& handle : handles) {
+      auto* group = &*handle;
+      for (auto fulls = group->fulls(); fulls; fulls &= fulls - 1) {
+        auto index = group->first(fulls);
+        auto hash = this->hash(group->key(index));
+        auto [target, slot] = vacancy(hash);
+        target->fill(slot, static_cast<int8_t>(hash >> 57), std::move(group->value(index)));
+      }
+    }
+    _allocator->destroy_n(handles);
+
+    _left = groups * flat_hash_group<T, KeyOf, Hash, Equal>::width * 7 / 8 - _size;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void flat_hash<T, KeyOf, Hash, Equal>::release() {
+    _allocator->destroy_n(_groups);
+    _groups.clear();
+  }
+
+  //////////////////////////
+  // Structure: accessors //
+  //////////////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  bool flat_hash<T, KeyOf, Hash, Equal>::empty() const {
+    return _size == 0;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint64_t flat_hash<T, KeyOf, Hash, Equal>::size() const {
+    return _size;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint64_t flat_hash<T, KeyOf, Hash, Equal>::capacity() const {
+    return _groups.size() * flat_hash_group<T, KeyOf, Hash, Equal>::width;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class K>
+  T* flat_hash<T, KeyOf, Hash, Equal>::find(const K& key) {
+    auto [group, index] = locate(key, hash(key));
+    return group ? &group->value(index) : nullptr;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class K>
+  const T* flat_hash<T, KeyOf, Hash, Equal>::find(const K& key) const {
+    auto [group, index] = locate(key, hash(key));
+    return group ? &group->value(index) : nullptr;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class Visit>
+  void flat_hash<T, KeyOf, Hash, Equal>::visit(Visit visit) const {
+    for (auto& handle : _groups) {
+      auto* group = &*handle;
+      for (auto fulls = group->fulls(); fulls; fulls &= fulls - 1) {
+        visit(static_cast<const T&>(group->value(group->first(fulls))));
+      }
+    }
+  }
+
+  /////////////////////////
+  // Structure: mutators //
+  /////////////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  std::pair<T*, bool> flat_hash<T, KeyOf, Hash, Equal>::insert(T value) {
+    auto hash = this->hash(KeyOf{}(static_cast<const T&>(value)));
+    if (auto [group, index] = locate(KeyOf{}(static_cast<const T&>(value)), hash); group) {
+      return {&group->value(index), false};
+    }
+
+    if (_left == 0) {
+      // when most of what's filling the table is deleted slots, rebuilding it
+      // at the same size is enough to clear them out.
+      auto groups = _groups.size();
+      resize(groups == 0 ? 1 : _size * 16 > capacity() * 7 ? groups * 2 : groups);
+    }
+
+    auto [group, index] = vacancy(hash);
+    if (group->_controls[index] == group->empty) {
+      _left--;
+    }
+    group->fill(index, static_cast<int8_t>(hash >> 57), std::move(value));
+    _size++;
+    return {&group->value(index), true};
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class K>
+  bool flat_hash<T, KeyOf, Hash, Equal>::remove(const K& key) {
+    auto [group, index] = locate(key, hash(key));
+    if (!group) {
+      return false;
+    }
+
+    group->erase(index);
+    if (group->_controls[index] == group->empty) {
+      _left++;
+    }
+    _size--;
+    return true;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void flat_hash<T, KeyOf, Hash, Equal>::clear() {
+    release();
+    _size = 0;
+    _left = 0;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_FLAT_HASH_IMPL_HH
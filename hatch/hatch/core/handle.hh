@@ -8,6 +8,7 @@
 #include <hatch/utility/owning.hh>
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   template <uint64_t S>
   class handle : public owned<allocated<S>, handle<S>> {
@@ -15,6 +16,8 @@ namespace hatch {
     friend class allocator;
 
   protected:
+    explicit handle(allocated<S>* owner);
+
     handle();
     ~handle();
 
@@ -25,6 +28,7 @@ namespace hatch {
     handle& operator=(const handle& ptr);
   };
 
+} // inline namespace HATCH_SLABTAG
 } // end namespace hatch
 
 #endif // HATCH_HANDLE_HH
@@ -8,6 +8,12 @@
 #include <cassert>
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
+
+  template <uint64_t S>
+  handle<S>::handle(allocated<S>* owner) :
+      owned<allocated<S>, handle<S>>::owned{owner} {
+  }
 
   template <uint64_t S>
   handle<S>::handle() :
@@ -29,7 +35,19 @@ namespace hatch {
     return *this;
   }
 
+  template <uint64_t S>
+  handle<S>::handle(const handle& copied) :
+      owned<allocated<S>, handle<S>>::owned{copied} {
+  }
+
+  template <uint64_t S>
+  handle<S>& handle<S>::operator=(const handle& copied) {
+    owned<allocated<S>, handle<S>>::operator=(copied);
+    return *this;
+  }
+
 
+} // inline namespace HATCH_SLABTAG
 } // namespace hatch
 
 #endif // HATCH_HANDLE_IMPL_HH
\ No newline at end of file
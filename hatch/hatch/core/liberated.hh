@@ -8,6 +8,7 @@
 #include <hatch/utility/tree.hh>
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   template <uint64_t S>
   class liberated : public tree_node<liberated<S>> {
@@ -26,10 +27,11 @@ namespace hatch {
     liberated& operator=(const liberated& copied) = delete;
 
   public:
-    bool operator<(const liberated& other);
-    bool operator>(const liberated& other);
+    bool operator<(const liberated& other) const;
+    bool operator>(const liberated& other) const;
   };
 
+} // inline namespace HATCH_SLABTAG
 } // namespace hatch
 
 #endif // HATCH_LIBERATED_HH
\ No newline at end of file
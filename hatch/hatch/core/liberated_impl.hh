@@ -6,6 +6,7 @@
 #endif
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   template <uint64_t S>
   liberated<S>::liberated() :
@@ -28,16 +29,17 @@ namespace hatch {
   }
 
   template <uint64_t S>
-  bool liberated<S>::operator<(const liberated& other) {
+  bool liberated<S>::operator<(const liberated& other) const {
     return this < &other;
   }
 
   template <uint64_t S>
-  bool liberated<S>::operator>(const liberated& other) {
+  bool liberated<S>::operator>(const liberated& other) const {
     return this > &other;
   }
 
 
+} // inline namespace HATCH_SLABTAG
 } // namespace hatch
 
 #endif // HATCH_LIBERATED_IMPL_HH
\ No newline at end of file
@@ -2,15 +2,21 @@
 #define HATCH_MEMORY_HH
 
 #include <hatch/core/memory_fwd.hh>
+#include <hatch/core/slabs.hh>
 #include <hatch/core/liberated.hh>
-#include <hatch/core/liberated_impl.hh>
 #include <hatch/core/allocated.hh>
-#include <hatch/core/allocated_impl.hh>
 #include <hatch/core/handle.hh>
-#include <hatch/core/handle_impl.hh>
 #include <hatch/core/pointer.hh>
-#include <hatch/core/pointer_impl.hh>
+#include <hatch/core/compressed.hh>
 #include <hatch/core/allocator.hh>
+#include <hatch/core/region.hh>
+
+#include <hatch/core/liberated_impl.hh>
+#include <hatch/core/allocated_impl.hh>
+#include <hatch/core/handle_impl.hh>
+#include <hatch/core/pointer_impl.hh>
+#include <hatch/core/compressed_impl.hh>
 #include <hatch/core/allocator_impl.hh>
+#include <hatch/core/region_impl.hh>
 
 #endif // HATCH_MEMORY_HH
@@ -1,21 +1,51 @@
 #ifndef HATCH_MEMORY_FWD_HH
 #define HATCH_MEMORY_FWD_HH
 
+#include <hatch/utility/integral.hh>
+
 #include <cstdint>
 
+// the slab class list decides the layout of the allocator and of every
+// handle, so it can only be chosen for the whole program, with HATCH_SLABLIST
+// and a HATCH_SLABTAG to name it, e.g.
+//
+//   -DHATCH_SLABLIST='geometric<8, 8192, 5, 4>' -DHATCH_SLABTAG=geometric_8_8192_5_4
+//
+// everything here lives in an inline namespace named by the tag, so objects
+// built with different lists refer to different symbols and fail to link
+// together, rather than quietly disagreeing about what an allocator is.
+#ifndef HATCH_SLABLIST
+#define HATCH_SLABLIST doubling<8, 8192>
+#define HATCH_SLABTAG doubling_8_8192
+#endif
+
+#ifndef HATCH_SLABTAG
+#error "HATCH_SLABLIST needs a HATCH_SLABTAG to name it."
+#endif
+
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   template <class T>
   class pointer;
 
+  template <class T, widths Width = widths::bits32>
+  class compressed;
+
   class allocator;
 
+  class region;
+
+  template <uint64_t S>
+  class handle;
+
   template <uint64_t S>
   class allocated;
 
   template <uint64_t S>
   class liberated;
 
+} // inline namespace HATCH_SLABTAG
 }
 
-#endif // HATCH_ASYNC_FWD_HH
+#endif // HATCH_MEMORY_FWD_HH
@@ -9,14 +9,19 @@
 #include <hatch/core/slabs.hh>
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   template <class T>
   class pointer : public handle<slab<T>> {
   public:
     friend class allocator;
+    friend class region;
+
+    template <class U, widths Width>
+    friend class compressed;
 
   private:
-    pointer(allocated<slab<T>>* allocated, allocator* allocator);
+    pointer(allocated<slab<T>>* owner, allocator* allocator);
 
   public:
     pointer();
@@ -32,12 +37,15 @@ namespace hatch {
     T* operator->();
     T& operator*();
 
-    explicit operator bool();
+    explicit operator bool() const;
 
   private:
     mutable allocator* _allocator{nullptr};
+
+    void release();
   };
 
+} // inline namespace HATCH_SLABTAG
 } // end namespace hatch
 
 #endif // HATCH_POINTER_HH
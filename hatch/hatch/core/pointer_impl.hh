@@ -8,10 +8,11 @@
 #include <cassert>
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
 
   template <class T>
   pointer<T>::pointer(allocated<slab<T>>* owner, allocator* allocator) :
-      handle<slab<T>>::handle{owner},
+      handle<slab<T>>{owner},
       _allocator{allocator} {
   }
 
@@ -22,40 +23,46 @@ namespace hatch {
 
   template <class T>
   pointer<T>::~pointer() {
-    if (_allocator && owned<allocated<slab<T>>, pointer<T>>::alone()) {
-      _allocator->destroy(*this);
-    }
+    release();
   }
 
   template <class T>
   pointer<T>::pointer(pointer&& ptr) noexcept :
-      handle<slab<T>>::owned{std::move(ptr)},
+      handle<slab<T>>{std::move(ptr)},
       _allocator{ptr._allocator} {
     ptr._allocator = nullptr;
   }
 
   template <class T>
-  pointer<T>& pointer<T>::operator=(pointer<T> &&ptr) noexcept {
-    handle<slab<T>>::operator=(std::move(ptr));
-    ptr._allocator = nullptr;
+  pointer<T>& pointer<T>::operator=(pointer<T>&& ptr) noexcept {
+    if (this != &ptr) {
+      release();
+      handle<slab<T>>::operator=(std::move(ptr));
+      _allocator = ptr._allocator;
+      ptr._allocator = nullptr;
+    }
     return *this;
   }
 
   template <class T>
   pointer<T>::pointer(const pointer& ptr) :
       handle<slab<T>>{ptr},
-  _allocator{ptr._allocator} {
+      _allocator{ptr._allocator} {
   }
 
   template <class T>
   pointer<T>& pointer<T>::operator=(const pointer& ptr) {
-    handle<slab<T>>::operator=(ptr);
+    if (this != &ptr) {
+      release();
+      handle<slab<T>>::operator=(ptr);
+      _allocator = ptr._allocator;
+    }
     return *this;
   }
 
   template <class T>
-  pointer<T>::operator bool() {
-    return _allocator;
+  pointer<T>::operator bool() const {
+    return this->_owner;
   }
 
   template <class T>
@@ -68,6 +75,15 @@ namespace hatch {
     return reinterpret_cast<T&>(this->_owner->_data);
   }
 
+  template <class T>
+  void pointer<T>::release() {
+    // the last handle to go takes the object down with it.
+    if (this->_owner && this->alone()) {
+      _allocator->destroy(*this);
+    }
+  }
+
+} // inline namespace HATCH_SLABTAG
 } // end namespace hatch
 
 #endif // HATCH_POINTER_IMPL_HH
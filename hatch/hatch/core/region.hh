@@ -0,0 +1,98 @@
+#ifndef HATCH_REGION_HH
+#define HATCH_REGION_HH
+
+#ifndef HATCH_MEMORY_HH
+#error "do not include region.hh directly. include memory.hh instead."
+#endif
+
+#include <hatch/core/allocator.hh>
+#include <hatch/utility/list.hh>
+
+#include <atomic> // std::atomic
+#include <cstddef> // std::byte
+#include <cstdint> // uint64_t
+
+namespace hatch {
+inline namespace HATCH_SLABTAG {
+
+  // a region hands out objects from chunks that are only ever given back all
+  // at once, by reset() or by the region going away. what that saves is the
+  // slab bookkeeping, not the teardown: every object still carries a record,
+  // and reset() walks the records of the objects that are still alive to run
+  // their destructors and null out their handles, so it costs O(live objects)
+  // plus O(chunks). objects that were already dropped cost nothing there.
+  //
+  // handles may be dropped on any thread. a drop that happens away from the
+  // owner finishes the object off on the spot, but its record is only queued
+  // up, and the owner unlinks it at the next reset().
+  class region {
+  public:
+    friend class allocator;
+
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
+
+  public:
+    explicit region(allocator& allocator);
+    ~region();
+
+    region(region&& moved) = delete;
+    region& operator=(region&& moved) = delete;
+
+    region(const region& copied) = delete;
+    region& operator=(const region& copied) = delete;
+
+    ////////////////
+    // Interface. //
+    ////////////////
+
+  public:
+    template <class T, class ...Args>
+    pointer<T> create(Args&&... args);
+
+    void reset();
+
+    //////////////
+    // Records. //
+    //////////////
+
+  private:
+    // every object is preceded by a record, which is what it takes to finish
+    // it off without knowing its type.
+    class record : public list_node<record> {
+    public:
+      explicit record(void (*finalize)(record*));
+
+      void (*_finalize)(record*);
+      record* _chained;
+    };
+
+    template <class T>
+    static void finalize(record* finalized);
+
+    void destroy(void* destroyed);
+    void drain();
+
+    list<record> _live;
+    std::atomic<record*> _remote;
+
+    /////////////
+    // Chunks. //
+    /////////////
+
+  private:
+    std::byte* place(uint64_t size, uint64_t alignment);
+    void extend();
+
+    allocator& _allocator;
+    list<allocator::page> _chunks;
+    list<allocator::page> _spares;
+    std::byte* _next;
+    std::byte* _end;
+  };
+
+} // inline namespace HATCH_SLABTAG
+} // namespace hatch
+
+#endif // HATCH_REGION_HH
@@ -0,0 +1,163 @@
+#ifndef HATCH_REGION_IMPL_HH
+#define HATCH_REGION_IMPL_HH
+
+#ifndef HATCH_REGION_HH
+#error "do not include region_impl.hh directly.  include memory.hh instead."
+#endif
+
+#include <new> // placement new
+#include <thread> // std::this_thread
+#include <type_traits> // std::is_trivially_destructible_v
+#include <utility> // std::forward
+
+#include <cassert> // assert
+#include <cstdint> // uintptr_t
+
+namespace hatch {
+inline namespace HATCH_SLABTAG {
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  inline region::region(allocator& allocator) :
+      _live{},
+      _remote{nullptr},
+      _allocator{allocator},
+      _chunks{},
+      _spares{},
+      _next{nullptr},
+      _end{nullptr} {
+  }
+
+  inline region::~region() {
+    reset();
+    while (auto* popped = _spares.pop_front()) {
+      popped->~page();
+      _allocator.unmap_page(popped);
+    }
+  }
+
+  ////////////////
+  // Interface. //
+  ////////////////
+
+  template <class T, class ...Args>
+  pointer<T> region::create(Args&&... args) {
+    assert(std::this_thread::get_id() == _allocator._thread);
+    static_assert(sizeof(allocator::page) + sizeof(record) + sizeof(allocated<slab<T>>) <= allocator::smallpage,
+        "type is too large for a chunk of the region.");
+    static_assert(alignof(T) <= alignof(allocated<slab<T>>),
+        "type is more strictly aligned than its slab.");
+
+    auto* placed = place(sizeof(allocated<slab<T>>), alignof(allocated<slab<T>>));
+    _live.push_back(*new (placed - sizeof(record)) record{&finalize<T>});
+
+    auto* created = new (placed) allocated<slab<T>>{};
+    created->template create<T>(std::forward<Args>(args)...);
+    return pointer<T>{created, &_allocator};
+  }
+
+  inline void region::reset() {
+    assert(std::this_thread::get_id() == _allocator._thread);
+
+    // only the objects that are still alive have to be visited. the chunks
+    // themselves are kept for the next round, so nothing goes back to the os.
+    drain();
+    while (auto* popped = _live.pop_front()) {
+      popped->_finalize(popped);
+      popped->~record();
+    }
+    _spares.push_front(_chunks);
+    _next = nullptr;
+    _end = nullptr;
+  }
+
+  //////////////
+  // Records. //
+  //////////////
+
+  inline region::record::record(void (*finalize)(record*)) :
+      list_node<record>{},
+      _finalize{finalize},
+      _chained{nullptr} {
+  }
+
+  template <class T>
+  void region::finalize(record* finalized) {
+    auto* destroyed = reinterpret_cast<allocated<slab<T>>*>(finalized + 1);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      destroyed->template destroy<T>();
+    }
+    destroyed->disown_all();
+    destroyed->~allocated();
+  }
+
+  inline void region::destroy(void* destroyed) {
+    auto* finalized = reinterpret_cast<record*>(destroyed) - 1;
+    finalized->_finalize(finalized);
+
+    // the list of live records belongs to the owner. anyone else leaves the
+    // record for the owner to unlink, the same way remote slab frees work.
+    if (std::this_thread::get_id() == _allocator._thread) {
+      _live.remove(*finalized);
+      finalized->~record();
+    } else {
+      finalized->_chained = _remote.load(std::memory_order_relaxed);
+      while (!_remote.compare_exchange_weak(finalized->_chained, finalized,
+          std::memory_order_release, std::memory_order_relaxed));
+    }
+  }
+
+  inline void region::drain() {
+    auto* drained = _remote.exchange(nullptr, std::memory_order_acquire);
+    while (drained) {
+      auto* next = drained->_chained;
+      _live.remove(*drained);
+      drained->~record();
+      drained = next;
+    }
+  }
+
+  /////////////
+  // Chunks. //
+  /////////////
+
+  inline std::byte* region::place(uint64_t size, uint64_t alignment) {
+    // the object goes at the first suitably aligned address with room for its
+    // record in front of it.
+    auto fit = [&]() -> std::byte* {
+      auto address = (reinterpret_cast<uintptr_t>(_next) + sizeof(record) + alignment - 1) & ~(alignment - 1);
+      if (address + size > reinterpret_cast<uintptr_t>(_end)) {
+        return nullptr;
+      }
+      return reinterpret_cast<std::byte*>(address);
+    };
+
+    auto* placed = _next ? fit() : nullptr;
+    if (!placed) {
+      extend();
+      placed = fit();
+      assert(placed);
+    }
+    _next = placed + size;
+    return placed;
+  }
+
+  inline void region::extend() {
+    auto* chunk = _spares.pop_front();
+    if (!chunk) {
+      auto* memory = _allocator.map_page();
+      chunk = new (memory) allocator::page{};
+      chunk->_region = this;
+    }
+    _chunks.push_back(*chunk);
+
+    _next = reinterpret_cast<std::byte*>(chunk + 1);
+    _end = reinterpret_cast<std::byte*>(chunk) + _allocator.pagesize();
+  }
+
+} // inline namespace HATCH_SLABTAG
+} // namespace hatch
+
+#endif // HATCH_REGION_IMPL_HH
@@ -5,9 +5,18 @@
 #error "do not include slabs.hh directly. include memory.hh instead."
 #endif
 
+#include <algorithm> // std::max
+#include <array> // std::array
+#include <type_traits> // std::conditional_t
+
 #include <cstdint> // uint64_t;
 
 namespace hatch {
+inline namespace HATCH_SLABTAG {
+
+  ////////////
+  // Slabs. //
+  ////////////
 
   template <uint64_t ...N>
   class slabs;
@@ -15,20 +24,82 @@ namespace hatch {
   template <uint64_t S, uint64_t ...N>
   class slabs<S, N...> {
   public:
+    static constexpr uint64_t count = 1 + sizeof...(N);
+
     template <class T>
-    static constexpr uint64_t slab = sizeof(T) < S ? S : slabs<N...>::template slab<T>;
+    static constexpr uint64_t slab = sizeof(T) <= S ? S : slabs<N...>::template slab<T>;
   };
 
   template <uint64_t S>
   class slabs<S> {
   public:
+    static constexpr uint64_t count = 1;
+
     template <class T>
-    static constexpr uint64_t slab = sizeof(T) < S ? S : sizeof(T);
+    static constexpr uint64_t slab = sizeof(T) <= S ? S : sizeof(T);
+  };
+
+  /////////////
+  // Series. //
+  /////////////
+
+  // each class is the previous one grown by num/den, rounded up to a multiple
+  // of eight bytes, and always at least eight bytes larger. the series stops
+  // at max, which is always the last class.
+  template <uint64_t S, uint64_t Max, uint64_t Num, uint64_t Den, uint64_t ...N>
+  class series {
+  private:
+    static constexpr uint64_t grown = (S * Num / Den + 7) / 8 * 8;
+    static constexpr uint64_t next = grown > S ? grown : S + 8;
+
+    template <class U>
+    class done {
+    public:
+      using type = U;
+    };
+
+  public:
+    using type = typename std::conditional_t<(S >= Max),
+        done<slabs<N..., Max>>,
+        series<next, Max, Num, Den, N..., S>>::type;
   };
 
+  template <uint64_t Min, uint64_t Max, uint64_t Num, uint64_t Den>
+  using geometric = typename series<Min, Max, Num, Den>::type;
+
+  template <uint64_t Min, uint64_t Max>
+  using doubling = geometric<Min, Max, 2, 1>;
+
+  // the class list is fixed for the whole program, since it decides the type
+  // of every handle. it can be swapped for another series at build time, see
+  // memory_fwd.hh.
+  using slablist = HATCH_SLABLIST;
+
   template <class T>
-  constexpr uint64_t slab = slabs<8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192>::template slab<T>;
+  constexpr uint64_t slab = slablist::template slab<T>;
+
+  ////////////
+  // Waste. //
+  ////////////
+
+  // how well a class list fits a set of types: the slab each one lands in and
+  // the bytes it leaves unused there, all known at compile time so that a
+  // list can be checked against the hot types with a static_assert.
+  template <class Slabs, class ...Ts>
+  class waste {
+  public:
+    static constexpr std::array<uint64_t, sizeof...(Ts)> sizes{sizeof(Ts)...};
+    static constexpr std::array<uint64_t, sizeof...(Ts)> classes{Slabs::template slab<Ts>...};
+    static constexpr std::array<uint64_t, sizeof...(Ts)> bytes{(Slabs::template slab<Ts> - sizeof(Ts))...};
+
+    static constexpr uint64_t total = (0 + ... + (Slabs::template slab<Ts> - sizeof(Ts)));
+    static constexpr uint64_t worst = std::max({uint64_t{0}, (Slabs::template slab<Ts> - sizeof(Ts))...});
+
+    // the unused share of the slab, in percent, for the worst fitting type.
+    static constexpr uint64_t percent = std::max({uint64_t{0}, (100 * (Slabs::template slab<Ts> - sizeof(Ts)) / Slabs::template slab<Ts>)...});
+  };
 
+} // inline namespace HATCH_SLABTAG
 } // namespace hatch
 
-#endif // HATCH_SLABS_HH
\ No newline at end of file
+#endif // HATCH_SLABS_HH
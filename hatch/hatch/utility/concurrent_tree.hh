@@ -0,0 +1,114 @@
+#ifndef HATCH_CONCURRENT_TREE_HH
+#define HATCH_CONCURRENT_TREE_HH
+
+#include <hatch/utility/tree.hh>
+#include <hatch/utility/published.hh>
+
+#include <atomic> // std::atomic
+#include <optional> // std::optional
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  // a tree that any number of threads can search while one thread at a time
+  // changes it. readers take no locks: they walk the links as they find them
+  // and then check against a sequence count that no change landed meanwhile,
+  // and start over if one did.
+  //
+  // a node taken out of the tree can still be in the middle of some reader's
+  // walk, or in its hands, so it can't be destroyed or put back with a
+  // different key until the writer has called synchronize.
+  template <class T, class KeyOf, class Compare, class Augment>
+  class concurrent_tree final {
+  public:
+    using node = tree_node<T, published, KeyOf, Compare, Augment>;
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    concurrent_tree();
+    ~concurrent_tree();
+
+    concurrent_tree(concurrent_tree&&) = delete;
+    concurrent_tree& operator=(concurrent_tree&&) = delete;
+
+    concurrent_tree(const concurrent_tree&) = delete;
+    concurrent_tree& operator=(const concurrent_tree&) = delete;
+
+    //////////////
+    // Readers. //
+    //////////////
+
+  public:
+    // keeps synchronize waiting for as long as it's held. a search holds one
+    // only while it walks, so a reader that's going to use what it finds has
+    // to hold its own around both the search and the use.
+    class reading;
+
+    reading guard() const;
+
+    template <class K>
+    T* find(const K& key) const;
+
+    template <class K>
+    T* lower_bound(const K& key) const;
+
+    template <class K>
+    T* upper_bound(const K& key) const;
+
+    bool empty() const;
+
+    /////////////
+    // Writer. //
+    /////////////
+
+  public:
+    void insert(node& node);
+    T* remove(node& node);
+    void clear();
+
+    // returns once every read that was under way when it was called is done,
+    // after which nodes removed before the call are no longer seen by anyone.
+    void synchronize() const;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    // readers announce themselves on one of a handful of counters, picked per
+    // thread, so that they don't all contend for the same cache line.
+    class alignas(64) stripe {
+    public:
+      std::atomic<uint64_t> _readers[2]{{0}, {0}};
+    };
+
+    static constexpr uint64_t stripes = 16;
+
+    // no balanced tree is deeper than this, so a walk that gets any further
+    // has been sent around in circles by a rotation and has to start over.
+    static constexpr uint64_t depth = 128;
+
+    class writing;
+
+    tree<T, published, KeyOf, Compare, Augment> _tree;
+    alignas(64) std::atomic<uint64_t> _sequence;
+
+    // which of each stripe's two counters new readers go on.
+    mutable std::atomic<uint64_t> _phase;
+    mutable stripe _stripes[stripes];
+
+    static uint64_t stripe_of_thread();
+
+    template <class Descend>
+    T* read(Descend descend) const;
+  };
+
+} // namespace hatch
+
+#include <hatch/utility/concurrent_tree_impl.hh>
+
+#endif // HATCH_CONCURRENT_TREE_HH
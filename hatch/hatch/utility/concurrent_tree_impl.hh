@@ -0,0 +1,216 @@
+#ifndef HATCH_CONCURRENT_TREE_IMPL_HH
+#define HATCH_CONCURRENT_TREE_IMPL_HH
+
+#ifndef HATCH_CONCURRENT_TREE_HH
+#error "do not include concurrent_tree_impl.hh directly. include concurrent_tree.hh instead."
+#endif
+
+#include <thread> // std::this_thread
+
+namespace hatch {
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  class concurrent_tree<T, KeyOf, Compare, Augment>::reading {
+  public:
+    explicit reading(const concurrent_tree& tree) :
+        _readers{tree._stripes[stripe_of_thread()]._readers[tree._phase.load(std::memory_order_relaxed) & 1]} {
+      // this has to be visible before anything the read looks at, or a writer
+      // could miss it and let a node go out from under the read.
+      _readers.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    ~reading() {
+      _readers.fetch_sub(1, std::memory_order_release);
+    }
+
+    reading(const reading&) = delete;
+    reading& operator=(const reading&) = delete;
+
+  private:
+    std::atomic<uint64_t>& _readers;
+  };
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  class concurrent_tree<T, KeyOf, Compare, Augment>::writing {
+  public:
+    explicit writing(concurrent_tree& tree) :
+        _tree{tree},
+        _sequence{tree._sequence.load(std::memory_order_relaxed)} {
+      // an odd count tells readers that a change is under way.
+      _tree._sequence.store(_sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    ~writing() {
+      _tree._sequence.store(_sequence + 2, std::memory_order_release);
+    }
+
+    writing(const writing&) = delete;
+    writing& operator=(const writing&) = delete;
+
+  private:
+    concurrent_tree& _tree;
+    uint64_t _sequence;
+  };
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  concurrent_tree<T, KeyOf, Compare, Augment>::concurrent_tree() :
+      _tree{},
+      _sequence{0},
+      _phase{0},
+      _stripes{} {
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  concurrent_tree<T, KeyOf, Compare, Augment>::~concurrent_tree() {
+    clear();
+  }
+
+  //////////////
+  // Readers. //
+  //////////////
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  typename concurrent_tree<T, KeyOf, Compare, Augment>::reading concurrent_tree<T, KeyOf, Compare, Augment>::guard() const {
+    return reading{*this};
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  template <class K>
+  T* concurrent_tree<T, KeyOf, Compare, Augment>::find(const K& key) const {
+    return read([&](const node* current) -> std::optional<const node*> {
+      for (auto steps = 0lu; current; steps++) {
+        if (steps == depth) {
+          return std::nullopt;
+        } else if (node::less(key, current->key())) {
+          current = current->prev();
+        } else if (node::less(current->key(), key)) {
+          current = current->next();
+        } else {
+          return current;
+        }
+      }
+      return nullptr;
+    });
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  template <class K>
+  T* concurrent_tree<T, KeyOf, Compare, Augment>::lower_bound(const K& key) const {
+    return read([&](const node* current) -> std::optional<const node*> {
+      const node* bound = nullptr;
+      for (auto steps = 0lu; current; steps++) {
+        if (steps == depth) {
+          return std::nullopt;
+        } else if (node::less(current->key(), key)) {
+          current = current->next();
+        } else {
+          bound = current;
+          current = current->prev();
+        }
+      }
+      return bound;
+    });
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  template <class K>
+  T* concurrent_tree<T, KeyOf, Compare, Augment>::upper_bound(const K& key) const {
+    return read([&](const node* current) -> std::optional<const node*> {
+      const node* bound = nullptr;
+      for (auto steps = 0lu; current; steps++) {
+        if (steps == depth) {
+          return std::nullopt;
+        } else if (node::less(key, current->key())) {
+          bound = current;
+          current = current->prev();
+        } else {
+          current = current->next();
+        }
+      }
+      return bound;
+    });
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  bool concurrent_tree<T, KeyOf, Compare, Augment>::empty() const {
+    return _tree.empty();
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  template <class Descend>
+  T* concurrent_tree<T, KeyOf, Compare, Augment>::read(Descend descend) const {
+    auto guard = reading{*this};
+    while (true) {
+      auto before = _sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue;
+      }
+
+      auto* root = _tree._root ? &*_tree._root : nullptr;
+      auto found = descend(root);
+
+      // the walk may have seen any mix of old and new links. it only counts if
+      // no change began or ended while it was going.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (found && _sequence.load(std::memory_order_relaxed) == before) {
+        return *found ? &(*found)->get() : nullptr;
+      }
+    }
+  }
+
+  /////////////
+  // Writer. //
+  /////////////
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  void concurrent_tree<T, KeyOf, Compare, Augment>::insert(node& node) {
+    auto guard = writing{*this};
+    _tree.insert(node);
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  T* concurrent_tree<T, KeyOf, Compare, Augment>::remove(node& node) {
+    auto guard = writing{*this};
+    return _tree.remove(node);
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  void concurrent_tree<T, KeyOf, Compare, Augment>::clear() {
+    auto guard = writing{*this};
+    _tree.clear();
+  }
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  void concurrent_tree<T, KeyOf, Compare, Augment>::synchronize() const {
+    // readers that start from here on count themselves on the other side, so
+    // the side that was current only ever drains, and a steady stream of new
+    // readers can't hold this up. a counter that's been seen empty once has
+    // nobody left on it from before; anyone who shows up on it later started
+    // after the removals and can't find those nodes anymore.
+    auto phase = _phase.fetch_add(1, std::memory_order_seq_cst) & 1;
+    for (auto& stripe : _stripes) {
+      while (stripe._readers[phase].load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  ////////////////
+  // Structure. //
+  ////////////////
+
+  template <class T, class KeyOf, class Compare, class Augment>
+  uint64_t concurrent_tree<T, KeyOf, Compare, Augment>::stripe_of_thread() {
+    static std::atomic<uint64_t> threads{0};
+    thread_local uint64_t stripe = threads.fetch_add(1, std::memory_order_relaxed) % stripes;
+    return stripe;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_CONCURRENT_TREE_IMPL_HH
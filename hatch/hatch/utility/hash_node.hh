@@ -0,0 +1,64 @@
+#ifndef HATCH_HASH_NODE_HH
+#define HATCH_HASH_NODE_HH
+
+#ifndef HATCH_HASH_TABLE_HH
+#error "do not include hash_node.hh directly. include hash_table.hh instead."
+#endif
+
+#include <hatch/utility/container.hh>
+#include <hatch/utility/meta.hh>
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  class hash_node : public container<T> {
+  public:
+    friend class hash_table<T, KeyOf, Hash, Equal>;
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    template <class ...Args>
+    explicit hash_node(Args&&... args);
+    ~hash_node();
+
+    // the chains are singly linked, so a node can't find what points at it.
+    hash_node(hash_node&&) = delete;
+    hash_node& operator=(hash_node&&) = delete;
+
+    hash_node(const hash_node&) = delete;
+    hash_node& operator=(const hash_node&) = delete;
+
+    ///////////
+    // Keys. //
+    ///////////
+
+  public:
+    T& get() const;
+    decltype(auto) key() const;
+
+    template <class K>
+    static uint64_t hash(const K& key);
+
+    template <class L, class R>
+    static bool equal(const L& lhs, const R& rhs);
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    hash_node* _next;
+
+    // kept so that moving the node to a bigger table, or passing it over on the
+    // way to another key, never has to hash it again.
+    uint64_t _hash;
+  };
+
+} // namespace hatch
+
+#endif // HATCH_HASH_NODE_HH
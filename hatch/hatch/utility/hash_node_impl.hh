@@ -0,0 +1,62 @@
+#ifndef HATCH_HASH_NODE_IMPL_HH
+#define HATCH_HASH_NODE_IMPL_HH
+
+#ifndef HATCH_HASH_TABLE_HH
+#error "do not include hash_node_impl.hh directly. include hash_table.hh instead."
+#endif
+
+#include <utility> // std::forward
+
+namespace hatch {
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class ...Args>
+  hash_node<T, KeyOf, Hash, Equal>::hash_node(Args&&... args) :
+      container<T>::container{std::forward<Args>(args)...},
+      _next{nullptr},
+      _hash{0} {
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_node<T, KeyOf, Hash, Equal>::~hash_node() {
+  }
+
+  ///////////
+  // Keys. //
+  ///////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  T& hash_node<T, KeyOf, Hash, Equal>::get() const {
+    if constexpr (complete<T>) {
+      return container<T>::get();
+    } else {
+      return const_cast<T&>(static_cast<const T&>(*this));
+    }
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  decltype(auto) hash_node<T, KeyOf, Hash, Equal>::key() const {
+    return KeyOf{}(get());
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class K>
+  uint64_t hash_node<T, KeyOf, Hash, Equal>::hash(const K& key) {
+    // standard hashes of integers are often the integers themselves, so the
+    // bits are stirred up before the top ones pick the bucket.
+    return Hash{}(key) * 0x9e3779b97f4a7c15lu;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class L, class R>
+  bool hash_node<T, KeyOf, Hash, Equal>::equal(const L& lhs, const R& rhs) {
+    return Equal{}(lhs, rhs);
+  }
+
+} // namespace hatch
+
+#endif // HATCH_HASH_NODE_IMPL_HH
@@ -0,0 +1,106 @@
+#ifndef HATCH_HASH_TABLE_HH
+#define HATCH_HASH_TABLE_HH
+
+#include <hatch/utility/hash_table_fwd.hh>
+
+#include <memory> // std::unique_ptr
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  // a chained hash table whose chains run through the nodes themselves, so
+  // that nothing is allocated per entry; only the bucket arrays are.
+  //
+  // when it outgrows its buckets, a table twice the size is set up next to the
+  // old one, and every insertion or removal after that carries a few of the old
+  // buckets over. lookups check both tables until the old one has been emptied,
+  // which is always done before the new one fills up in turn.
+  template <class T, class KeyOf, class Hash, class Equal>
+  class hash_table final {
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
+
+  public:
+    hash_table();
+    ~hash_table();
+
+    hash_table(hash_table&& moved) noexcept;
+    hash_table& operator=(hash_table&& moved) noexcept;
+
+    hash_table(const hash_table&) = delete;
+    hash_table& operator=(const hash_table&) = delete;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    // a table of buckets, as many as a power of two.
+    class buckets {
+    public:
+      std::unique_ptr<hash_node<T, KeyOf, Hash, Equal>*[]> _chains;
+      uint64_t _bits;
+
+      uint64_t count() const;
+
+      hash_node<T, KeyOf, Hash, Equal>*& chain(uint64_t hash);
+      hash_node<T, KeyOf, Hash, Equal>* const& chain(uint64_t hash) const;
+    };
+
+    static constexpr uint64_t initial = 3;
+
+    // how many old buckets each change carries over while growing.
+    static constexpr uint64_t step = 4;
+
+    buckets _current;
+    buckets _previous;
+    uint64_t _migrated;
+    uint64_t _size;
+
+    bool growing() const;
+    void grow();
+    void migrate();
+
+    // the new table's buckets are only set up as the old ones are carried
+    // over, so only this many of them are in use yet.
+    uint64_t settled() const;
+
+    hash_node<T, KeyOf, Hash, Equal>*& chain(uint64_t hash);
+    hash_node<T, KeyOf, Hash, Equal>* const& chain(uint64_t hash) const;
+
+    //////////////////////////
+    // Structure: accessors //
+    //////////////////////////
+
+  public:
+    bool empty() const;
+    uint64_t size() const;
+
+    // the first node found with the key, or null.
+    template <class K>
+    T* find(const K& key) const;
+
+    template <class Visit>
+    void visit(Visit visit) const;
+
+    /////////////////////////
+    // Structure: mutators //
+    /////////////////////////
+
+  public:
+    // nodes with equal keys can all go in; it's up to the caller to look first.
+    void insert(hash_node<T, KeyOf, Hash, Equal>& node);
+    T* remove(hash_node<T, KeyOf, Hash, Equal>& node);
+    void clear();
+  };
+
+} // namespace hatch
+
+#include <hatch/utility/hash_node.hh>
+
+#include <hatch/utility/hash_table_impl.hh>
+#include <hatch/utility/hash_node_impl.hh>
+
+#endif // HATCH_HASH_TABLE_HH
@@ -0,0 +1,29 @@
+#ifndef HATCH_HASH_TABLE_FWD_HH
+#define HATCH_HASH_TABLE_FWD_HH
+
+#include <hatch/utility/tree_fwd.hh>
+
+#include <functional> // std::equal_to, std::hash
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  // unless told otherwise, a hash table hashes its keys the standard way.
+  class hashed {
+  public:
+    template <class K>
+    uint64_t operator()(const K& key) const {
+      return std::hash<K>{}(key);
+    }
+  };
+
+  template <class T, class KeyOf = identity, class Hash = hashed, class Equal = std::equal_to<>>
+  class hash_table;
+
+  template <class T, class KeyOf = identity, class Hash = hashed, class Equal = std::equal_to<>>
+  class hash_node;
+
+} // namespace hatch
+
+#endif // HATCH_HASH_TABLE_FWD_HH
@@ -0,0 +1,252 @@
+#ifndef HATCH_HASH_TABLE_IMPL_HH
+#define HATCH_HASH_TABLE_IMPL_HH
+
+#ifndef HATCH_HASH_TABLE_HH
+#error "do not include hash_table_impl.hh directly. include hash_table.hh instead."
+#endif
+
+#include <algorithm> // std::min
+#include <utility> // std::move
+
+namespace hatch {
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_table<T, KeyOf, Hash, Equal>::hash_table() :
+      _current{{}, 0},
+      _previous{{}, 0},
+      _migrated{0},
+      _size{0} {
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_table<T, KeyOf, Hash, Equal>::~hash_table() {
+    clear();
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_table<T, KeyOf, Hash, Equal>::hash_table(hash_table&& moved) noexcept :
+      _current{std::move(moved._current)},
+      _previous{std::move(moved._previous)},
+      _migrated{moved._migrated},
+      _size{moved._size} {
+    moved._current = buckets{{}, 0};
+    moved._previous = buckets{{}, 0};
+    moved._migrated = 0;
+    moved._size = 0;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_table<T, KeyOf, Hash, Equal>& hash_table<T, KeyOf, Hash, Equal>::operator=(hash_table&& moved) noexcept {
+    if (this != &moved) {
+      clear();
+      _current = std::move(moved._current);
+      _previous = std::move(moved._previous);
+      _migrated = moved._migrated;
+      _size = moved._size;
+      moved._current = buckets{{}, 0};
+      moved._previous = buckets{{}, 0};
+      moved._migrated = 0;
+      moved._size = 0;
+    }
+    return *this;
+  }
+
+  ////////////////
+  // Structure. //
+  ////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint64_t hash_table<T, KeyOf, Hash, Equal>::buckets::count() const {
+    return _chains ? uint64_t{1} << _bits : 0;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_node<T, KeyOf, Hash, Equal>*& hash_table<T, KeyOf, Hash, Equal>::buckets::chain(uint64_t hash) {
+    // the top bits pick the bucket, so that doubling the table splits every
+    // bucket into two neighbors.
+    return _chains[hash >> (64 - _bits)];
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_node<T, KeyOf, Hash, Equal>* const& hash_table<T, KeyOf, Hash, Equal>::buckets::chain(uint64_t hash) const {
+    return _chains[hash >> (64 - _bits)];
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  bool hash_table<T, KeyOf, Hash, Equal>::growing() const {
+    return static_cast<bool>(_previous._chains);
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void hash_table<T, KeyOf, Hash, Equal>::grow() {
+    // the new buckets are left as they come, so that growing costs the same
+    // no matter how big the table is. a big enough array comes straight from
+    // the os, and none of it is touched until the buckets are carried over.
+    _previous = std::move(_current);
+    _current = buckets{std::unique_ptr<hash_node<T, KeyOf, Hash, Equal>*[]>{new hash_node<T, KeyOf, Hash, Equal>*[_previous.count() * 2]}, _previous._bits + 1};
+    _migrated = 0;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void hash_table<T, KeyOf, Hash, Equal>::migrate() {
+    // an old bucket splits into the two new ones next to each other at twice
+    // its index, which are set up right before its nodes go into them.
+    auto end = std::min(_migrated + step, _previous.count());
+    for (; _migrated < end; _migrated++) {
+      _current._chains[_migrated * 2] = nullptr;
+      _current._chains[_migrated * 2 + 1] = nullptr;
+
+      auto* node = _previous._chains[_migrated];
+      _previous._chains[_migrated] = nullptr;
+      while (node) {
+        auto* next = node->_next;
+        auto& chain = _current.chain(node->_hash);
+        node->_next = chain;
+        chain = node;
+        node = next;
+      }
+    }
+
+    // the old array goes back whole. it was never written past what the
+    // buckets used, and nothing in it needs destroying.
+    if (_migrated == _previous.count()) {
+      _previous = buckets{{}, 0};
+      _migrated = 0;
+    }
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint64_t hash_table<T, KeyOf, Hash, Equal>::settled() const {
+    return growing() ? _migrated * 2 : _current.count();
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_node<T, KeyOf, Hash, Equal>*& hash_table<T, KeyOf, Hash, Equal>::chain(uint64_t hash) {
+    // a bucket of the old table that hasn't been carried over yet is still
+    // where its nodes are.
+    if (growing() && (hash >> (64 - _previous._bits)) >= _migrated) {
+      return _previous.chain(hash);
+    }
+    return _current.chain(hash);
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  hash_node<T, KeyOf, Hash, Equal>* const& hash_table<T, KeyOf, Hash, Equal>::chain(uint64_t hash) const {
+    return const_cast<hash_table<T, KeyOf, Hash, Equal>&>(*this).chain(hash);
+  }
+
+  //////////////////////////
+  // Structure: accessors //
+  //////////////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  bool hash_table<T, KeyOf, Hash, Equal>::empty() const {
+    return _size == 0;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  uint64_t hash_table<T, KeyOf, Hash, Equal>::size() const {
+    return _size;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class K>
+  T* hash_table<T, KeyOf, Hash, Equal>::find(const K& key) const {
+    if (_size == 0) {
+      return nullptr;
+    }
+
+    auto hash = hash_node<T, KeyOf, Hash, Equal>::hash(key);
+    for (auto* node = chain(hash); node; node = node->_next) {
+      if (node->_hash == hash && node->equal(node->key(), key)) {
+        return &node->get();
+      }
+    }
+    return nullptr;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  template <class Visit>
+  void hash_table<T, KeyOf, Hash, Equal>::visit(Visit visit) const {
+    if (growing()) {
+      for (auto index = _migrated; index < _previous.count(); index++) {
+        for (auto* node = _previous._chains[index]; node; node = node->_next) {
+          visit(node->get());
+        }
+      }
+    }
+    for (auto index = 0lu; index < settled(); index++) {
+      for (auto* node = _current._chains[index]; node; node = node->_next) {
+        visit(node->get());
+      }
+    }
+  }
+
+  /////////////////////////
+  // Structure: mutators //
+  /////////////////////////
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void hash_table<T, KeyOf, Hash, Equal>::insert(hash_node<T, KeyOf, Hash, Equal>& node) {
+    if (!_current._chains) {
+      _current = buckets{std::unique_ptr<hash_node<T, KeyOf, Hash, Equal>*[]>{new hash_node<T, KeyOf, Hash, Equal>*[uint64_t{1} << initial]()}, initial};
+    } else if (growing()) {
+      migrate();
+    } else if (_size >= _current.count()) {
+      grow();
+      migrate();
+    }
+
+    node._hash = node.hash(node.key());
+    auto& chain = this->chain(node._hash);
+    node._next = chain;
+    chain = &node;
+    _size++;
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  T* hash_table<T, KeyOf, Hash, Equal>::remove(hash_node<T, KeyOf, Hash, Equal>& node) {
+    for (auto** link = &chain(node._hash); *link; link = &(*link)->_next) {
+      if (*link == &node) {
+        *link = node._next;
+        node._next = nullptr;
+        _size--;
+        break;
+      }
+    }
+
+    if (growing()) {
+      migrate();
+    }
+    return &node.get();
+  }
+
+  template <class T, class KeyOf, class Hash, class Equal>
+  void hash_table<T, KeyOf, Hash, Equal>::clear() {
+    auto unlink = [](hash_node<T, KeyOf, Hash, Equal>* chain) {
+      while (chain) {
+        auto* next = chain->_next;
+        chain->_next = nullptr;
+        chain = next;
+      }
+    };
+    for (auto index = _migrated; index < _previous.count(); index++) {
+      unlink(_previous._chains[index]);
+    }
+    for (auto index = 0lu; index < settled(); index++) {
+      unlink(_current._chains[index]);
+    }
+
+    _previous = buckets{{}, 0};
+    _current = buckets{{}, 0};
+    _migrated = 0;
+    _size = 0;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_HASH_TABLE_IMPL_HH
@@ -0,0 +1,80 @@
+#ifndef HATCH_HEAP_HH
+#define HATCH_HEAP_HH
+
+#include <hatch/utility/heap_fwd.hh>
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  // a pairing heap: the least node is at the root and every node is no less
+  // than its head. inserting or merging just hangs one root off the other, and
+  // all the work of restoring order happens when the root is popped, which
+  // pairs off its children and merges the pairs back together. that comes to
+  // constant time for an insert and logarithmic time, amortized, for a pop.
+  //
+  // there's no order to walk, so unlike the list and the tree there are no
+  // iterators; nodes are reached by reference.
+  template <class T, class KeyOf, class Compare>
+  class heap final {
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
+
+  public:
+    heap();
+    ~heap();
+
+    heap(heap&& moved) noexcept;
+    heap& operator=(heap&& moved) noexcept;
+
+    heap(const heap&) = delete;
+    heap& operator=(const heap&) = delete;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    heap_node<T, KeyOf, Compare>* _root;
+    uint64_t _size;
+
+    //////////////////////////
+    // Structure: accessors //
+    //////////////////////////
+
+  public:
+    bool empty() const;
+    uint64_t size() const;
+    T* top() const;
+
+    /////////////////////////
+    // Structure: mutators //
+    /////////////////////////
+
+  public:
+    void insert(heap_node<T, KeyOf, Compare>& node);
+    T* pop();
+    T* remove(heap_node<T, KeyOf, Compare>& node);
+
+    // after a node's key has gone down, only it and what's under it can be out
+    // of place, so it's cut loose and merged back in at the root.
+    void decrease(heap_node<T, KeyOf, Compare>& node);
+
+    // after a node's key has changed either way.
+    void update(heap_node<T, KeyOf, Compare>& node);
+
+    // takes every node out of the other heap.
+    void merge(heap& other);
+
+    void clear();
+  };
+
+} // namespace hatch
+
+#include <hatch/utility/heap_node.hh>
+
+#include <hatch/utility/heap_impl.hh>
+#include <hatch/utility/heap_node_impl.hh>
+
+#endif // HATCH_HEAP_HH
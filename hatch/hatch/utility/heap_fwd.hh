@@ -0,0 +1,18 @@
+#ifndef HATCH_HEAP_FWD_HH
+#define HATCH_HEAP_FWD_HH
+
+#include <hatch/utility/tree_fwd.hh>
+
+#include <functional> // std::less
+
+namespace hatch {
+
+  template <class T, class KeyOf = identity, class Compare = std::less<>>
+  class heap;
+
+  template <class T, class KeyOf = identity, class Compare = std::less<>>
+  class heap_node;
+
+} // namespace hatch
+
+#endif // HATCH_HEAP_FWD_HH
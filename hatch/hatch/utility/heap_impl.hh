@@ -0,0 +1,144 @@
+#ifndef HATCH_HEAP_IMPL_HH
+#define HATCH_HEAP_IMPL_HH
+
+#ifndef HATCH_HEAP_HH
+#error "do not include heap_impl.hh directly. include heap.hh instead."
+#endif
+
+namespace hatch {
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  template <class T, class KeyOf, class Compare>
+  heap<T, KeyOf, Compare>::heap() :
+      _root{nullptr},
+      _size{0} {
+  }
+
+  template <class T, class KeyOf, class Compare>
+  heap<T, KeyOf, Compare>::~heap() {
+    clear();
+  }
+
+  template <class T, class KeyOf, class Compare>
+  heap<T, KeyOf, Compare>::heap(heap&& moved) noexcept :
+      _root{moved._root},
+      _size{moved._size} {
+    moved._root = nullptr;
+    moved._size = 0;
+  }
+
+  template <class T, class KeyOf, class Compare>
+  heap<T, KeyOf, Compare>& heap<T, KeyOf, Compare>::operator=(heap&& moved) noexcept {
+    if (this != &moved) {
+      clear();
+      _root = moved._root;
+      _size = moved._size;
+      moved._root = nullptr;
+      moved._size = 0;
+    }
+    return *this;
+  }
+
+  //////////////////////////
+  // Structure: accessors //
+  //////////////////////////
+
+  template <class T, class KeyOf, class Compare>
+  bool heap<T, KeyOf, Compare>::empty() const {
+    return !_root;
+  }
+
+  template <class T, class KeyOf, class Compare>
+  uint64_t heap<T, KeyOf, Compare>::size() const {
+    return _size;
+  }
+
+  template <class T, class KeyOf, class Compare>
+  T* heap<T, KeyOf, Compare>::top() const {
+    return _root ? &_root->get() : nullptr;
+  }
+
+  /////////////////////////
+  // Structure: mutators //
+  /////////////////////////
+
+  template <class T, class KeyOf, class Compare>
+  void heap<T, KeyOf, Compare>::insert(heap_node<T, KeyOf, Compare>& node) {
+    _root = heap_node<T, KeyOf, Compare>::meld(_root, &node);
+    _size++;
+  }
+
+  template <class T, class KeyOf, class Compare>
+  T* heap<T, KeyOf, Compare>::pop() {
+    return _root ? remove(*_root) : nullptr;
+  }
+
+  template <class T, class KeyOf, class Compare>
+  T* heap<T, KeyOf, Compare>::remove(heap_node<T, KeyOf, Compare>& node) {
+    // the children of the node close up into a heap of their own, which takes
+    // the place of the node: at the root if that's where it was, or else merged
+    // back in from the top.
+    auto* children = heap_node<T, KeyOf, Compare>::combine(node._child);
+    node._child = nullptr;
+    if (&node == _root) {
+      _root = children;
+    } else {
+      node.cut();
+      _root = heap_node<T, KeyOf, Compare>::meld(_root, children);
+    }
+    _size--;
+    return &node.get();
+  }
+
+  template <class T, class KeyOf, class Compare>
+  void heap<T, KeyOf, Compare>::decrease(heap_node<T, KeyOf, Compare>& node) {
+    if (&node != _root) {
+      node.cut();
+      _root = heap_node<T, KeyOf, Compare>::meld(_root, &node);
+    }
+  }
+
+  template <class T, class KeyOf, class Compare>
+  void heap<T, KeyOf, Compare>::update(heap_node<T, KeyOf, Compare>& node) {
+    remove(node);
+    insert(node);
+  }
+
+  template <class T, class KeyOf, class Compare>
+  void heap<T, KeyOf, Compare>::merge(heap& other) {
+    if (this != &other) {
+      _root = heap_node<T, KeyOf, Compare>::meld(_root, other._root);
+      _size += other._size;
+      other._root = nullptr;
+      other._size = 0;
+    }
+  }
+
+  template <class T, class KeyOf, class Compare>
+  void heap<T, KeyOf, Compare>::clear() {
+    // the nodes waiting to be reset are chained through their next links, and
+    // each one adds its children to the chain as it's reset.
+    auto* pending = _root;
+    while (pending) {
+      auto* node = pending;
+      pending = node->_next;
+      for (auto* child = node->_child; child;) {
+        auto* sibling = child->_next;
+        child->_next = pending;
+        pending = child;
+        child = sibling;
+      }
+      node->_child = nullptr;
+      node->_prev = nullptr;
+      node->_next = nullptr;
+    }
+    _root = nullptr;
+    _size = 0;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_HEAP_IMPL_HH
@@ -0,0 +1,72 @@
+#ifndef HATCH_HEAP_NODE_HH
+#define HATCH_HEAP_NODE_HH
+
+#ifndef HATCH_HEAP_HH
+#error "do not include heap_node.hh directly. include heap.hh instead."
+#endif
+
+#include <hatch/utility/container.hh>
+#include <hatch/utility/meta.hh>
+
+namespace hatch {
+
+  template <class T, class KeyOf, class Compare>
+  class heap_node : public container<T> {
+  public:
+    friend class heap<T, KeyOf, Compare>;
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    template <class ...Args>
+    explicit heap_node(Args&&... args);
+    ~heap_node();
+
+    // the root is known only to its heap, so a node can't move on its own.
+    heap_node(heap_node&&) = delete;
+    heap_node& operator=(heap_node&&) = delete;
+
+    heap_node(const heap_node&) = delete;
+    heap_node& operator=(const heap_node&) = delete;
+
+    ///////////
+    // Keys. //
+    ///////////
+
+  public:
+    T& get() const;
+    decltype(auto) key() const;
+
+    template <class L, class R>
+    static bool less(const L& lhs, const R& rhs);
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    // the children of a node are a chain of siblings hanging off the first. the
+    // first child's prev is its head, and everyone else's is the sibling before.
+    heap_node* _child;
+    heap_node* _prev;
+    heap_node* _next;
+
+  public:
+    bool alone() const;
+
+    //////////////////////////
+    // Structure: mutators. //
+    //////////////////////////
+
+  private:
+    void cut();
+
+    static heap_node* meld(heap_node* first, heap_node* second);
+    static heap_node* combine(heap_node* siblings);
+  };
+
+} // namespace hatch
+
+#endif // HATCH_HEAP_NODE_HH
@@ -0,0 +1,138 @@
+#ifndef HATCH_HEAP_NODE_IMPL_HH
+#define HATCH_HEAP_NODE_IMPL_HH
+
+#ifndef HATCH_HEAP_HH
+#error "do not include heap_node_impl.hh directly. include heap.hh instead."
+#endif
+
+#include <utility> // std::forward, std::swap
+
+namespace hatch {
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Compare>
+  template <class ...Args>
+  heap_node<T, KeyOf, Compare>::heap_node(Args&&... args) :
+      container<T>::container{std::forward<Args>(args)...},
+      _child{nullptr},
+      _prev{nullptr},
+      _next{nullptr} {
+  }
+
+  template <class T, class KeyOf, class Compare>
+  heap_node<T, KeyOf, Compare>::~heap_node() {
+  }
+
+  ///////////
+  // Keys. //
+  ///////////
+
+  template <class T, class KeyOf, class Compare>
+  T& heap_node<T, KeyOf, Compare>::get() const {
+    if constexpr (complete<T>) {
+      return container<T>::get();
+    } else {
+      return const_cast<T&>(static_cast<const T&>(*this));
+    }
+  }
+
+  template <class T, class KeyOf, class Compare>
+  decltype(auto) heap_node<T, KeyOf, Compare>::key() const {
+    return KeyOf{}(get());
+  }
+
+  template <class T, class KeyOf, class Compare>
+  template <class L, class R>
+  bool heap_node<T, KeyOf, Compare>::less(const L& lhs, const R& rhs) {
+    return Compare{}(lhs, rhs);
+  }
+
+  ////////////////
+  // Structure. //
+  ////////////////
+
+  template <class T, class KeyOf, class Compare>
+  bool heap_node<T, KeyOf, Compare>::alone() const {
+    return !_child && !_prev && !_next;
+  }
+
+  //////////////////////////
+  // Structure: mutators. //
+  //////////////////////////
+
+  template <class T, class KeyOf, class Compare>
+  void heap_node<T, KeyOf, Compare>::cut() {
+    // takes this node and everything under it out of the chain it's in.
+    if (_prev) {
+      if (_prev->_child == this) {
+        _prev->_child = _next;
+      } else {
+        _prev->_next = _next;
+      }
+    }
+    if (_next) {
+      _next->_prev = _prev;
+    }
+    _prev = nullptr;
+    _next = nullptr;
+  }
+
+  template <class T, class KeyOf, class Compare>
+  heap_node<T, KeyOf, Compare>* heap_node<T, KeyOf, Compare>::meld(heap_node* first, heap_node* second) {
+    // both have to be roots. on a tie the first one stays on top.
+    if (!first) {
+      return second;
+    } else if (!second) {
+      return first;
+    }
+
+    if (less(second->key(), first->key())) {
+      std::swap(first, second);
+    }
+
+    second->_next = first->_child;
+    if (first->_child) {
+      first->_child->_prev = second;
+    }
+    second->_prev = first;
+    first->_child = second;
+    return first;
+  }
+
+  template <class T, class KeyOf, class Compare>
+  heap_node<T, KeyOf, Compare>* heap_node<T, KeyOf, Compare>::combine(heap_node* siblings) {
+    // the two passes: meld the siblings in pairs from the front, then meld the
+    // pairs together from the back. the pairs are chained up in reverse as
+    // they're made, so that the second pass is just a walk down that chain.
+    heap_node* pairs = nullptr;
+    while (siblings) {
+      auto* first = siblings;
+      auto* second = first->_next;
+      siblings = second ? second->_next : nullptr;
+
+      first->_prev = first->_next = nullptr;
+      if (second) {
+        second->_prev = second->_next = nullptr;
+      }
+
+      auto* pair = meld(first, second);
+      pair->_next = pairs;
+      pairs = pair;
+    }
+
+    heap_node* root = nullptr;
+    while (pairs) {
+      auto* pair = pairs;
+      pairs = pair->_next;
+      pair->_next = nullptr;
+      root = meld(root, pair);
+    }
+    return root;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_HEAP_NODE_IMPL_HH
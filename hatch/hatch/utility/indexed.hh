@@ -2,20 +2,42 @@
 #define HATCH_INDEXED_HH
 
 #include <hatch/utility/integral.hh>
+#include <hatch/utility/meta.hh>
 
 #include <cstddef>
 
 namespace hatch {
 
-  template <class T, widths Width, nosignint<Width> Stride = sizeof(T), nosignint<Width> Offset = 0>
+  // an index counts whole elements of the array it points into. usually those
+  // are just what it refers to, but a type that is only ever a base of the
+  // elements, like a node that its payload derives from, can name them.
+  template <class T, class = void>
+  class elements {
+  public:
+    using type = T;
+  };
+
+  template <class T>
+  class elements<T, voided<typename T::element>> {
+  public:
+    using type = typename T::element;
+  };
+
+  // without a stride, the elements are laid out as an array of their own type,
+  // which is only looked at once the type is complete. a tagged index gives up
+  // its top bit for its holder to keep a flag in.
+  template <class T, widths Width, nosignint<Width> Stride = 0, nosignint<Width> Offset = 0, bool Tagged = false>
   class indexed {
   private:
     using index = nosignint<Width>;
-    static constexpr auto null = nosignmax<Width>;
+    static constexpr index tagbit = Tagged ? index(index(1) << (sizeof(index) * 8 - 1)) : index(0);
+    static constexpr index null = nosignmax<Width> & index(~tagbit);
 
   public:
     class context;
 
+    static constexpr bool tagged = Tagged;
+
   public:
     indexed();
     ~indexed();
@@ -29,6 +51,12 @@ namespace hatch {
     indexed(T* address);
     indexed& operator=(T* address);
 
+  public:
+    // the tag stays with the index it was set on: it isn't copied along with
+    // the element, and pointing the index somewhere else leaves it alone.
+    bool tag() const;
+    void make_tag(bool tag);
+
   public:
     operator bool() const;
 
@@ -41,8 +69,18 @@ namespace hatch {
   private:
     index _index;
     static __thread std::byte* _context;
+
+    static index locate(T* address);
+    T* address() const;
   };
 
+  // links for structures that live in a single array, with a bit to spare.
+  template <class T>
+  using indexed16 = indexed<T, widths::bits16, 0, 0, true>;
+
+  template <class T>
+  using indexed32 = indexed<T, widths::bits32, 0, 0, true>;
+
 }
 
 #include <hatch/utility/indexed_impl.hh>
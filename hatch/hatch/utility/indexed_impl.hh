@@ -7,8 +7,8 @@
 
 namespace hatch {
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  class indexed<T, Width, Stride, Offset>::context {
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  class indexed<T, Width, Stride, Offset, Tagged>::context {
   public:
     context() = delete;
 
@@ -29,78 +29,115 @@ namespace hatch {
     }
   };
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  __thread std::byte* indexed<T, Width, Stride, Offset>::_context = nullptr;
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  __thread std::byte* indexed<T, Width, Stride, Offset, Tagged>::_context = nullptr;
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>::indexed() :
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>::indexed() :
       _index{null} {
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>::~indexed() {
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>::~indexed() {
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>::indexed(indexed&& moved) noexcept :
-      _index{moved._index} {
-    moved._index = null;
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>::indexed(indexed&& moved) noexcept :
+      _index{index(moved._index & null)} {
+    moved._index = index((moved._index & tagbit) | null);
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>& indexed<T, Width, Stride, Offset>::operator=(indexed&& moved) {
-    _index = moved._index;
-    moved._index = null;
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>& indexed<T, Width, Stride, Offset, Tagged>::operator=(indexed&& moved) {
+    _index = index((_index & tagbit) | (moved._index & null));
+    moved._index = index((moved._index & tagbit) | null);
     return *this;
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>::indexed(const indexed& copied) :
-      _index{copied._index} {
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>::indexed(const indexed& copied) :
+      _index{index(copied._index & null)} {
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>& indexed<T, Width, Stride, Offset>::operator=(const indexed& copied) {
-    _index = copied._index;
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>& indexed<T, Width, Stride, Offset, Tagged>::operator=(const indexed& copied) {
+    _index = index((_index & tagbit) | (copied._index & null));
     return *this;
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>::indexed(T* address) :
-      _index{address ? (index)(reinterpret_cast<std::byte*>(address) - _context - Offset)/(Stride) : null} {
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>::indexed(T* address) :
+      _index{locate(address)} {
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>& indexed<T, Width, Stride, Offset>::operator=(T* address) {
-    _index = address ? (index)(reinterpret_cast<std::byte*>(address) - _context - Offset)/(Stride) : null;
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>& indexed<T, Width, Stride, Offset, Tagged>::operator=(T* address) {
+    _index = index((_index & tagbit) | locate(address));
     return *this;
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  indexed<T, Width, Stride, Offset>::operator bool() const {
-    return _index != null;
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  bool indexed<T, Width, Stride, Offset, Tagged>::tag() const {
+    static_assert(Tagged, "only tagged indices have room for a tag.");
+    return _index & tagbit;
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  T& indexed<T, Width, Stride, Offset>::operator*() {
-    return *reinterpret_cast<T*>(_context + _index * Stride + Offset);
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  void indexed<T, Width, Stride, Offset, Tagged>::make_tag(bool tag) {
+    static_assert(Tagged, "only tagged indices have room for a tag.");
+    _index = index((_index & null) | (tag ? tagbit : index(0)));
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  const T& indexed<T, Width, Stride, Offset>::operator*() const {
-    return const_cast<indexed<T, Width, Stride, Offset>&>(*this).operator*();
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  indexed<T, Width, Stride, Offset, Tagged>::operator bool() const {
+    return (_index & null) != null;
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  T* indexed<T, Width, Stride, Offset>::operator->() {
-    return reinterpret_cast<T*>(_context + _index * Stride + Offset);
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  T& indexed<T, Width, Stride, Offset, Tagged>::operator*() {
+    return *address();
   }
 
-  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset>
-  const T* indexed<T, Width, Stride, Offset>::operator->() const {
-    return const_cast<indexed<T, Width, Stride, Offset>&>(*this).operator->();
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  const T& indexed<T, Width, Stride, Offset, Tagged>::operator*() const {
+    return *address();
+  }
+
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  T* indexed<T, Width, Stride, Offset, Tagged>::operator->() {
+    return address();
+  }
+
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  const T* indexed<T, Width, Stride, Offset, Tagged>::operator->() const {
+    return address();
+  }
+
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  typename indexed<T, Width, Stride, Offset, Tagged>::index indexed<T, Width, Stride, Offset, Tagged>::locate(T* address) {
+    if (!address) {
+      return null;
+    }
+    if constexpr (Stride != 0) {
+      return (index)((reinterpret_cast<std::byte*>(address) - _context - Offset)/(Stride));
+    } else {
+      using element = typename elements<T>::type;
+      auto* whole = static_cast<element*>(address);
+      return (index)((reinterpret_cast<std::byte*>(whole) - _context)/sizeof(element));
+    }
+  }
+
+  template <class T, widths Width, nosignint<Width> Stride, nosignint<Width> Offset, bool Tagged>
+  T* indexed<T, Width, Stride, Offset, Tagged>::address() const {
+    auto position = index(_index & null);
+    if constexpr (Stride != 0) {
+      return reinterpret_cast<T*>(_context + position * Stride + Offset);
+    } else {
+      using element = typename elements<T>::type;
+      return static_cast<T*>(reinterpret_cast<element*>(_context + position * sizeof(element)));
+    }
   }
 
 } // namespace hatch
 
-#endif // HATCH_INDEXED_IMPL_HH
\ No newline at end of file
+#endif // HATCH_INDEXED_IMPL_HH
@@ -67,6 +67,8 @@ namespace hatch {
     T* pop_back();
     void push_back(list_node<T>& node);
     void push_back(list<T>& list);
+
+    T* remove(list_node<T>& node);
   };
 
 } // namespace hatch
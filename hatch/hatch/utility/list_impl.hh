@@ -171,6 +171,24 @@ namespace hatch {
     list._head = nullptr;
   }
 
+  template <class T>
+  T* list<T>::remove(list_node<T>& node) {
+    this->disown_all();
+    auto* removed = &node;
+    if (removed->alone()) {
+      if (removed == _head) {
+        _head = nullptr;
+      }
+    } else {
+      auto* next = &removed->next();
+      removed->splice(*next);
+      if (removed == _head) {
+        _head = next;
+      }
+    }
+    return &removed->get();
+  }
+
 } // namespace hatch
 
 #endif // HATCH_LIST_ROOT_IMPL_HH
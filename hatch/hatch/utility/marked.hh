@@ -0,0 +1,56 @@
+#ifndef HATCH_MARKED_HH
+#define HATCH_MARKED_HH
+
+#include <cstdint> // uintptr_t
+
+namespace hatch {
+
+  // a plain pointer that keeps a flag in its lowest bit, which is always clear
+  // in the address of anything aligned to two bytes or more.
+  template <class T>
+  class marked {
+  public:
+    static constexpr bool tagged = true;
+
+  public:
+    marked();
+    ~marked();
+
+    marked(marked&& moved) noexcept;
+    marked& operator=(marked&& moved);
+
+    marked(const marked& copied);
+    marked& operator=(const marked& copied);
+
+    marked(T* address);
+    marked& operator=(T* address);
+
+  public:
+    // the tag stays with the pointer it was set on: it isn't copied along with
+    // the address, and pointing it somewhere else leaves it alone.
+    bool tag() const;
+    void make_tag(bool tag);
+
+  public:
+    operator bool() const;
+
+    T& operator*();
+    const T& operator*() const;
+
+    T* operator->();
+    const T* operator->() const;
+
+  private:
+    static constexpr uintptr_t tagbit = 1;
+
+    uintptr_t _bits;
+
+    static uintptr_t locate(T* address);
+    T* address() const;
+  };
+
+} // namespace hatch
+
+#include <hatch/utility/marked_impl.hh>
+
+#endif // HATCH_MARKED_HH
@@ -0,0 +1,102 @@
+#ifndef HATCH_MARKED_IMPL_HH
+#define HATCH_MARKED_IMPL_HH
+
+#ifndef HATCH_MARKED_HH
+#error "do not include marked_impl.hh directly.  include marked.hh instead."
+#endif
+
+namespace hatch {
+
+  template <class T>
+  marked<T>::marked() :
+      _bits{0} {
+  }
+
+  template <class T>
+  marked<T>::~marked() {
+  }
+
+  template <class T>
+  marked<T>::marked(marked&& moved) noexcept :
+      _bits{moved._bits & ~tagbit} {
+    moved._bits &= tagbit;
+  }
+
+  template <class T>
+  marked<T>& marked<T>::operator=(marked&& moved) {
+    _bits = (_bits & tagbit) | (moved._bits & ~tagbit);
+    moved._bits &= tagbit;
+    return *this;
+  }
+
+  template <class T>
+  marked<T>::marked(const marked& copied) :
+      _bits{copied._bits & ~tagbit} {
+  }
+
+  template <class T>
+  marked<T>& marked<T>::operator=(const marked& copied) {
+    _bits = (_bits & tagbit) | (copied._bits & ~tagbit);
+    return *this;
+  }
+
+  template <class T>
+  marked<T>::marked(T* address) :
+      _bits{locate(address)} {
+  }
+
+  template <class T>
+  marked<T>& marked<T>::operator=(T* address) {
+    _bits = (_bits & tagbit) | locate(address);
+    return *this;
+  }
+
+  template <class T>
+  bool marked<T>::tag() const {
+    return _bits & tagbit;
+  }
+
+  template <class T>
+  void marked<T>::make_tag(bool tag) {
+    _bits = (_bits & ~tagbit) | (tag ? tagbit : 0);
+  }
+
+  template <class T>
+  marked<T>::operator bool() const {
+    return (_bits & ~tagbit) != 0;
+  }
+
+  template <class T>
+  T& marked<T>::operator*() {
+    return *address();
+  }
+
+  template <class T>
+  const T& marked<T>::operator*() const {
+    return *address();
+  }
+
+  template <class T>
+  T* marked<T>::operator->() {
+    return address();
+  }
+
+  template <class T>
+  const T* marked<T>::operator->() const {
+    return address();
+  }
+
+  template <class T>
+  uintptr_t marked<T>::locate(T* address) {
+    static_assert(alignof(T) > tagbit, "the lowest bit of the address has to be free for the tag.");
+    return reinterpret_cast<uintptr_t>(address);
+  }
+
+  template <class T>
+  T* marked<T>::address() const {
+    return reinterpret_cast<T*>(_bits & ~tagbit);
+  }
+
+} // namespace hatch
+
+#endif // HATCH_MARKED_IMPL_HH
@@ -22,6 +22,16 @@ namespace hatch {
   template<class T>
   constexpr bool complete<T, voided<decltype(sizeof(T))>> = true;
 
+  /**
+   * Taggable
+   */
+
+  template<class, class = void>
+  constexpr bool taggable = false;
+
+  template<class T>
+  constexpr bool taggable<T, voided<decltype(T::tagged)>> = T::tagged;
+
   /**
    * Wrappers
    */
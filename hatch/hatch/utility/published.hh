@@ -0,0 +1,62 @@
+#ifndef HATCH_PUBLISHED_HH
+#define HATCH_PUBLISHED_HH
+
+#include <atomic> // std::atomic
+
+#include <cstdint> // uintptr_t
+
+namespace hatch {
+
+  // a pointer that can be read by other threads while it's being rewritten.
+  // loading it sees everything that was written to its target before it was
+  // stored. like marked, it keeps a tag in the lowest bit of the address.
+  template <class T>
+  class published {
+  public:
+    static constexpr bool tagged = true;
+
+  public:
+    published();
+    ~published();
+
+    published(published&& moved) noexcept;
+    published& operator=(published&& moved);
+
+    published(const published& copied);
+    published& operator=(const published& copied);
+
+    published(T* address);
+    published& operator=(T* address);
+
+  public:
+    bool tag() const;
+    void make_tag(bool tag);
+
+  public:
+    operator bool() const;
+
+    T& operator*();
+    const T& operator*() const;
+
+    T* operator->();
+    const T* operator->() const;
+
+  private:
+    static constexpr uintptr_t tagbit = 1;
+
+    std::atomic<uintptr_t> _bits;
+
+    // only one thread ever stores, so the tag can be kept with a plain load
+    // and store rather than a read-modify-write.
+    uintptr_t load() const;
+    void store(uintptr_t bits);
+
+    static uintptr_t locate(T* address);
+    T* address() const;
+  };
+
+} // namespace hatch
+
+#include <hatch/utility/published_impl.hh>
+
+#endif // HATCH_PUBLISHED_HH
@@ -0,0 +1,112 @@
+#ifndef HATCH_PUBLISHED_IMPL_HH
+#define HATCH_PUBLISHED_IMPL_HH
+
+#ifndef HATCH_PUBLISHED_HH
+#error "do not include published_impl.hh directly.  include published.hh instead."
+#endif
+
+namespace hatch {
+
+  template <class T>
+  published<T>::published() :
+      _bits{0} {
+  }
+
+  template <class T>
+  published<T>::~published() {
+  }
+
+  template <class T>
+  published<T>::published(published&& moved) noexcept :
+      _bits{moved.load() & ~tagbit} {
+    moved.store(moved.load() & tagbit);
+  }
+
+  template <class T>
+  published<T>& published<T>::operator=(published&& moved) {
+    store((load() & tagbit) | (moved.load() & ~tagbit));
+    moved.store(moved.load() & tagbit);
+    return *this;
+  }
+
+  template <class T>
+  published<T>::published(const published& copied) :
+      _bits{copied.load() & ~tagbit} {
+  }
+
+  template <class T>
+  published<T>& published<T>::operator=(const published& copied) {
+    store((load() & tagbit) | (copied.load() & ~tagbit));
+    return *this;
+  }
+
+  template <class T>
+  published<T>::published(T* address) :
+      _bits{locate(address)} {
+  }
+
+  template <class T>
+  published<T>& published<T>::operator=(T* address) {
+    store((load() & tagbit) | locate(address));
+    return *this;
+  }
+
+  template <class T>
+  bool published<T>::tag() const {
+    return load() & tagbit;
+  }
+
+  template <class T>
+  void published<T>::make_tag(bool tag) {
+    store((load() & ~tagbit) | (tag ? tagbit : 0));
+  }
+
+  template <class T>
+  published<T>::operator bool() const {
+    return (load() & ~tagbit) != 0;
+  }
+
+  template <class T>
+  T& published<T>::operator*() {
+    return *address();
+  }
+
+  template <class T>
+  const T& published<T>::operator*() const {
+    return *address();
+  }
+
+  template <class T>
+  T* published<T>::operator->() {
+    return address();
+  }
+
+  template <class T>
+  const T* published<T>::operator->() const {
+    return address();
+  }
+
+  template <class T>
+  uintptr_t published<T>::load() const {
+    return _bits.load(std::memory_order_acquire);
+  }
+
+  template <class T>
+  void published<T>::store(uintptr_t bits) {
+    _bits.store(bits, std::memory_order_release);
+  }
+
+  template <class T>
+  uintptr_t published<T>::locate(T* address) {
+    static_assert(alignof(T) > tagbit, "the lowest bit of the address has to be free for the tag.");
+    return reinterpret_cast<uintptr_t>(address);
+  }
+
+  template <class T>
+  T* published<T>::address() const {
+    return reinterpret_cast<T*>(load() & ~tagbit);
+  }
+
+} // namespace hatch
+
+#endif // HATCH_PUBLISHED_IMPL_HH
@@ -0,0 +1,123 @@
+#ifndef HATCH_SKIPLIST_HH
+#define HATCH_SKIPLIST_HH
+
+#include <hatch/utility/skiplist_fwd.hh>
+
+#include <atomic> // std::atomic, std::atomic_thread_fence
+
+#include <cstdint> // uint64_t, uintptr_t
+
+namespace hatch {
+
+  // an ordered list of nodes with express lanes: every node is on the bottom
+  // level, about a quarter of them on the next one up, and so on, so a search
+  // skips most of the list. the links are swung with compare-and-swap, so any
+  // number of threads can insert, remove and search at once without a lock.
+  //
+  // a node is taken out in two steps: first its own links are marked, which
+  // takes it out as far as anyone looking is concerned, and then whoever comes
+  // across it next unlinks it for good. other threads can be looking at a node
+  // for a while after it's gone, so it can't be destroyed or put back in until
+  // they're all done with it.
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  class skiplist final {
+  public:
+    friend class skiplist_iterator<T, KeyOf, Compare, Height>;
+
+    static_assert(Height > 0 && Height <= 32, "a skip list needs at least one level, and 32 covers any list.");
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    skiplist();
+    ~skiplist();
+
+    skiplist(skiplist&&) = delete;
+    skiplist& operator=(skiplist&&) = delete;
+
+    skiplist(const skiplist&) = delete;
+    skiplist& operator=(const skiplist&) = delete;
+
+    ////////////////
+    // Iterators. //
+    ////////////////
+
+  public:
+    skiplist_iterator<T, KeyOf, Compare, Height> begin() const;
+    skiplist_iterator<T, KeyOf, Compare, Height> end() const;
+
+    template <class K>
+    skiplist_iterator<T, KeyOf, Compare, Height> find(const K& key) const;
+
+    template <class K>
+    skiplist_iterator<T, KeyOf, Compare, Height> lower_bound(const K& key) const;
+
+    template <class K>
+    skiplist_iterator<T, KeyOf, Compare, Height> upper_bound(const K& key) const;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    std::atomic<uintptr_t> _head[Height];
+
+    // the links just before and just after a position, on every level.
+    class window {
+    public:
+      std::atomic<uintptr_t>* _prevs[Height];
+      skiplist_node<T, KeyOf, Compare, Height>* _nexts[Height];
+    };
+
+    // finds the window around the first node that isn't before the position,
+    // unlinking whatever marked nodes it passes along the way.
+    template <class Before>
+    void locate(Before before, window& window);
+
+    template <class Before>
+    bool sweep(Before before, window& window);
+
+    // the first node that isn't before the position, just by looking.
+    template <class Before>
+    skiplist_node<T, KeyOf, Compare, Height>* seek(Before before) const;
+
+    static uint64_t random_height();
+
+    //////////////////////////
+    // Structure: accessors //
+    //////////////////////////
+
+  public:
+    bool empty() const;
+    T* front() const;
+
+    /////////////////////////
+    // Structure: mutators //
+    /////////////////////////
+
+  public:
+    // nodes with equal keys all go in, in no particular order among themselves.
+    void insert(skiplist_node<T, KeyOf, Compare, Height>& node);
+
+    // true for the one caller that actually took the node out.
+    bool remove(skiplist_node<T, KeyOf, Compare, Height>& node);
+
+    // takes out the first node, or returns null when there's nothing left.
+    T* pop();
+
+    // only when nobody else is using the list.
+    void clear();
+  };
+
+} // namespace hatch
+
+#include <hatch/utility/skiplist_node.hh>
+#include <hatch/utility/skiplist_iterator.hh>
+
+#include <hatch/utility/skiplist_impl.hh>
+#include <hatch/utility/skiplist_node_impl.hh>
+#include <hatch/utility/skiplist_iterator_impl.hh>
+
+#endif // HATCH_SKIPLIST_HH
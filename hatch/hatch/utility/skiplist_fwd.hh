@@ -0,0 +1,23 @@
+#ifndef HATCH_SKIPLIST_FWD_HH
+#define HATCH_SKIPLIST_FWD_HH
+
+#include <hatch/utility/tree_fwd.hh>
+
+#include <functional> // std::less
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  template <class T, class KeyOf = identity, class Compare = std::less<>, uint64_t Height = 12>
+  class skiplist;
+
+  template <class T, class KeyOf = identity, class Compare = std::less<>, uint64_t Height = 12>
+  class skiplist_node;
+
+  template <class T, class KeyOf = identity, class Compare = std::less<>, uint64_t Height = 12>
+  class skiplist_iterator;
+
+} // namespace hatch
+
+#endif // HATCH_SKIPLIST_FWD_HH
@@ -0,0 +1,289 @@
+#ifndef HATCH_SKIPLIST_IMPL_HH
+#define HATCH_SKIPLIST_IMPL_HH
+
+#ifndef HATCH_SKIPLIST_HH
+#error "do not include skiplist_impl.hh directly. include skiplist.hh instead."
+#endif
+
+namespace hatch {
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist<T, KeyOf, Compare, Height>::skiplist() :
+      _head{} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist<T, KeyOf, Compare, Height>::~skiplist() {
+    clear();
+  }
+
+  ////////////////
+  // Iterators. //
+  ////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_iterator<T, KeyOf, Compare, Height> skiplist<T, KeyOf, Compare, Height>::begin() const {
+    return skiplist_iterator<T, KeyOf, Compare, Height>{seek([](auto*) {
+      return false;
+    })};
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_iterator<T, KeyOf, Compare, Height> skiplist<T, KeyOf, Compare, Height>::end() const {
+    return skiplist_iterator<T, KeyOf, Compare, Height>{};
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  template <class K>
+  skiplist_iterator<T, KeyOf, Compare, Height> skiplist<T, KeyOf, Compare, Height>::find(const K& key) const {
+    auto* found = seek([&](auto* node) {
+      return node->less(node->key(), key);
+    });
+    return found && !found->less(key, found->key()) ? skiplist_iterator<T, KeyOf, Compare, Height>{found} : end();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  template <class K>
+  skiplist_iterator<T, KeyOf, Compare, Height> skiplist<T, KeyOf, Compare, Height>::lower_bound(const K& key) const {
+    return skiplist_iterator<T, KeyOf, Compare, Height>{seek([&](auto* node) {
+      return node->less(node->key(), key);
+    })};
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  template <class K>
+  skiplist_iterator<T, KeyOf, Compare, Height> skiplist<T, KeyOf, Compare, Height>::upper_bound(const K& key) const {
+    return skiplist_iterator<T, KeyOf, Compare, Height>{seek([&](auto* node) {
+      return !node->less(key, node->key());
+    })};
+  }
+
+  ////////////////
+  // Structure. //
+  ////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  template <class Before>
+  void skiplist<T, KeyOf, Compare, Height>::locate(Before before, window& window) {
+    while (!sweep(before, window)) {
+    }
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  template <class Before>
+  bool skiplist<T, KeyOf, Compare, Height>::sweep(Before before, window& window) {
+    using node = skiplist_node<T, KeyOf, Compare, Height>;
+
+    auto* prev = _head;
+    for (auto level = Height; level-- > 0;) {
+      auto* current = node::target(prev[level].load(std::memory_order_acquire));
+      while (current) {
+        auto next = current->_links[level].load(std::memory_order_acquire);
+        if (next & node::marked) {
+          // losing the race to unlink it means the links just looked at are
+          // stale, and the only safe place to pick up again is the top.
+          auto expected = node::link(current);
+          if (!prev[level].compare_exchange_strong(expected, next & ~node::marked, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return false;
+          }
+          current = node::target(next);
+        } else if (before(current)) {
+          prev = current->_links;
+          current = node::target(next);
+        } else {
+          break;
+        }
+      }
+      window._prevs[level] = prev;
+      window._nexts[level] = current;
+    }
+    return true;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  template <class Before>
+  skiplist_node<T, KeyOf, Compare, Height>* skiplist<T, KeyOf, Compare, Height>::seek(Before before) const {
+    using node = skiplist_node<T, KeyOf, Compare, Height>;
+
+    // marked nodes are stepped over instead of unlinked, so that looking never
+    // writes to anything.
+    const std::atomic<uintptr_t>* prev = _head;
+    node* current = nullptr;
+    for (auto level = Height; level-- > 0;) {
+      current = node::target(prev[level].load(std::memory_order_acquire));
+      while (current) {
+        auto next = current->_links[level].load(std::memory_order_acquire);
+        if (next & node::marked) {
+          current = node::target(next);
+        } else if (before(current)) {
+          prev = current->_links;
+          current = node::target(next);
+        } else {
+          break;
+        }
+      }
+    }
+    return current;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  uint64_t skiplist<T, KeyOf, Compare, Height>::random_height() {
+    // each level up holds about a quarter of the one below.
+    thread_local uint64_t state = reinterpret_cast<uintptr_t>(&state) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    auto bits = state;
+    auto height = 1lu;
+    while (height < Height && (bits & 3) == 0) {
+      height++;
+      bits >>= 2;
+    }
+    return height;
+  }
+
+  //////////////////////////
+  // Structure: accessors //
+  //////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  bool skiplist<T, KeyOf, Compare, Height>::empty() const {
+    return !begin();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  T* skiplist<T, KeyOf, Compare, Height>::front() const {
+    auto first = begin();
+    return first ? &*first : nullptr;
+  }
+
+  /////////////////////////
+  // Structure: mutators //
+  /////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  void skiplist<T, KeyOf, Compare, Height>::insert(skiplist_node<T, KeyOf, Compare, Height>& node) {
+    using node_type = skiplist_node<T, KeyOf, Compare, Height>;
+
+    auto* inserted = &node;
+    auto before = [inserted](node_type* current) {
+      return node_type::before(current, inserted);
+    };
+
+    inserted->_height = random_height();
+    for (auto level = 0lu; level < Height; level++) {
+      inserted->_links[level].store(0, std::memory_order_relaxed);
+    }
+
+    // the node is in once it's on the bottom level...
+    auto window = skiplist::window{};
+    while (true) {
+      locate(before, window);
+      for (auto level = 0lu; level < inserted->_height; level++) {
+        inserted->_links[level].store(node_type::link(window._nexts[level]), std::memory_order_relaxed);
+      }
+      auto expected = node_type::link(window._nexts[0]);
+      if (window._prevs[0][0].compare_exchange_strong(expected, node_type::link(inserted), std::memory_order_acq_rel, std::memory_order_acquire)) {
+        break;
+      }
+    }
+
+    // ...and the levels above only make it quicker to find. if it's removed
+    // while they're going up, the removal may already have swept past this
+    // level before it was linked, so it's swept again from here. after that
+    // nothing links to it, and it can be put back once everyone's done.
+    for (auto level = 1lu; level < inserted->_height; level++) {
+      while (true) {
+        auto expected = node_type::link(window._nexts[level]);
+        if (window._prevs[level][level].compare_exchange_strong(expected, node_type::link(inserted), std::memory_order_acq_rel, std::memory_order_acquire)) {
+          // a removal marks first and then sweeps, while this links first and
+          // then checks for a mark. acquire and release alone would let both
+          // sides read what was there before, leaving this level linked to a
+          // removed node. the fences, here and in remove(), rule that out.
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if (inserted->_links[level].load(std::memory_order_acquire) & node_type::marked) {
+            locate(before, window);
+            return;
+          }
+          break;
+        }
+
+        locate(before, window);
+        auto link = inserted->_links[level].load(std::memory_order_acquire);
+        if (link & node_type::marked) {
+          return;
+        }
+        if (link != node_type::link(window._nexts[level]) &&
+            !inserted->_links[level].compare_exchange_strong(link, node_type::link(window._nexts[level]), std::memory_order_acq_rel, std::memory_order_acquire)) {
+          return;
+        }
+      }
+    }
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  bool skiplist<T, KeyOf, Compare, Height>::remove(skiplist_node<T, KeyOf, Compare, Height>& node) {
+    using node_type = skiplist_node<T, KeyOf, Compare, Height>;
+
+    auto* removed = &node;
+
+    // marking from the top down means that by the time the bottom link is
+    // marked, nothing can be linked in after the node on any level.
+    for (auto level = removed->_height; level-- > 1;) {
+      auto link = removed->_links[level].load(std::memory_order_acquire);
+      while (!(link & node_type::marked)) {
+        removed->_links[level].compare_exchange_weak(link, link | node_type::marked, std::memory_order_acq_rel, std::memory_order_acquire);
+      }
+    }
+
+    auto link = removed->_links[0].load(std::memory_order_acquire);
+    while (!(link & node_type::marked)) {
+      if (removed->_links[0].compare_exchange_weak(link, link | node_type::marked, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        // pairs with the fence in insert(), so that either the sweep sees an
+        // upper level that was linked in late, or the insertion sees the mark.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto window = skiplist::window{};
+        locate([removed](node_type* current) {
+          return node_type::before(current, removed);
+        }, window);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  T* skiplist<T, KeyOf, Compare, Height>::pop() {
+    for (auto first = begin(); first; first = begin()) {
+      if (remove(*first._node)) {
+        return &*first;
+      }
+    }
+    return nullptr;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  void skiplist<T, KeyOf, Compare, Height>::clear() {
+    using node = skiplist_node<T, KeyOf, Compare, Height>;
+
+    auto* current = node::target(_head[0].load(std::memory_order_acquire));
+    while (current) {
+      auto* next = node::target(current->_links[0].load(std::memory_order_relaxed));
+      for (auto& link : current->_links) {
+        link.store(0, std::memory_order_relaxed);
+      }
+      current = next;
+    }
+    for (auto& link : _head) {
+      link.store(0, std::memory_order_release);
+    }
+  }
+
+} // namespace hatch
+
+#endif // HATCH_SKIPLIST_IMPL_HH
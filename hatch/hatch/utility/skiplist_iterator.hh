@@ -0,0 +1,74 @@
+#ifndef HATCH_SKIPLIST_ITERATOR_HH
+#define HATCH_SKIPLIST_ITERATOR_HH
+
+#ifndef HATCH_SKIPLIST_HH
+#error "do not include skiplist_iterator.hh directly. include skiplist.hh instead."
+#endif
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  // the list is shared between threads, so unlike the other iterators this one
+  // isn't owned by its list. it walks the bottom level, stepping over whatever
+  // has been taken out by the time it gets there.
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  class skiplist_iterator final {
+  public:
+    friend class skiplist<T, KeyOf, Compare, Height>;
+
+    ///////////////////////////////////////////
+    // Constructors, destructor, assignment. //
+    ///////////////////////////////////////////
+
+  private:
+    explicit skiplist_iterator(skiplist_node<T, KeyOf, Compare, Height>* node);
+
+  public:
+    skiplist_iterator();
+    ~skiplist_iterator();
+
+    skiplist_iterator(skiplist_iterator&& moved) noexcept = default;
+    skiplist_iterator& operator=(skiplist_iterator&& moved) noexcept = default;
+
+    skiplist_iterator(const skiplist_iterator& copied) = default;
+    skiplist_iterator& operator=(const skiplist_iterator& copied) = default;
+
+    //////////////////
+    // Comparisons. //
+    //////////////////
+
+  public:
+    operator bool() const;
+    bool operator==(const skiplist_iterator& compared) const;
+    bool operator!=(const skiplist_iterator& compared) const;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    skiplist_node<T, KeyOf, Compare, Height>* _node;
+
+    static skiplist_node<T, KeyOf, Compare, Height>* present(skiplist_node<T, KeyOf, Compare, Height>* node);
+
+    /////////////////////////////////////
+    // Structure: get underlying data. //
+    /////////////////////////////////////
+
+  public:
+    T& operator*() const;
+    T* operator->() const;
+
+    ///////////////////////////////
+    // Structure: move iterator. //
+    ///////////////////////////////
+
+  public:
+    skiplist_iterator& operator++();
+    skiplist_iterator operator++(int);
+  };
+
+} // namespace hatch
+
+#endif // HATCH_SKIPLIST_ITERATOR_HH
@@ -0,0 +1,94 @@
+#ifndef HATCH_SKIPLIST_ITERATOR_IMPL_HH
+#define HATCH_SKIPLIST_ITERATOR_IMPL_HH
+
+#ifndef HATCH_SKIPLIST_HH
+#error "do not include skiplist_iterator_impl.hh directly. include skiplist.hh instead."
+#endif
+
+namespace hatch {
+
+  ///////////////////////////////////////////
+  // Constructors, destructor, assignment. //
+  ///////////////////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_iterator<T, KeyOf, Compare, Height>::skiplist_iterator(skiplist_node<T, KeyOf, Compare, Height>* node) :
+      _node{node} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_iterator<T, KeyOf, Compare, Height>::skiplist_iterator() :
+      _node{nullptr} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_iterator<T, KeyOf, Compare, Height>::~skiplist_iterator() {
+  }
+
+  //////////////////
+  // Comparisons. //
+  //////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_iterator<T, KeyOf, Compare, Height>::operator bool() const {
+    return _node;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  bool skiplist_iterator<T, KeyOf, Compare, Height>::operator==(const skiplist_iterator& compared) const {
+    return _node == compared._node;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  bool skiplist_iterator<T, KeyOf, Compare, Height>::operator!=(const skiplist_iterator& compared) const {
+    return !operator==(compared);
+  }
+
+  ////////////////
+  // Structure. //
+  ////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_node<T, KeyOf, Compare, Height>* skiplist_iterator<T, KeyOf, Compare, Height>::present(skiplist_node<T, KeyOf, Compare, Height>* node) {
+    while (node && node->removed()) {
+      node = skiplist_node<T, KeyOf, Compare, Height>::target(node->_links[0].load(std::memory_order_acquire));
+    }
+    return node;
+  }
+
+  /////////////////////////////////////
+  // Structure: get underlying data. //
+  /////////////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  T& skiplist_iterator<T, KeyOf, Compare, Height>::operator*() const {
+    return _node->get();
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  T* skiplist_iterator<T, KeyOf, Compare, Height>::operator->() const {
+    return &_node->get();
+  }
+
+  ///////////////////////////////
+  // Structure: move iterator. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_iterator<T, KeyOf, Compare, Height>& skiplist_iterator<T, KeyOf, Compare, Height>::operator++() {
+    if (_node) {
+      _node = present(skiplist_node<T, KeyOf, Compare, Height>::target(_node->_links[0].load(std::memory_order_acquire)));
+    }
+    return *this;
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_iterator<T, KeyOf, Compare, Height> skiplist_iterator<T, KeyOf, Compare, Height>::operator++(int) {
+    auto copy = *this;
+    operator++();
+    return copy;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_SKIPLIST_ITERATOR_IMPL_HH
@@ -0,0 +1,75 @@
+#ifndef HATCH_SKIPLIST_NODE_HH
+#define HATCH_SKIPLIST_NODE_HH
+
+#ifndef HATCH_SKIPLIST_HH
+#error "do not include skiplist_node.hh directly. include skiplist.hh instead."
+#endif
+
+#include <hatch/utility/container.hh>
+#include <hatch/utility/meta.hh>
+
+#include <atomic> // std::atomic
+
+#include <cstdint> // uint64_t, uintptr_t
+
+namespace hatch {
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  class skiplist_node : public container<T> {
+  public:
+    friend class skiplist<T, KeyOf, Compare, Height>;
+    friend class skiplist_iterator<T, KeyOf, Compare, Height>;
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    template <class ...Args>
+    explicit skiplist_node(Args&&... args);
+    ~skiplist_node();
+
+    // other threads can hold on to a node by its address at any moment.
+    skiplist_node(skiplist_node&&) = delete;
+    skiplist_node& operator=(skiplist_node&&) = delete;
+
+    skiplist_node(const skiplist_node&) = delete;
+    skiplist_node& operator=(const skiplist_node&) = delete;
+
+    ///////////
+    // Keys. //
+    ///////////
+
+  public:
+    T& get() const;
+    decltype(auto) key() const;
+
+    template <class L, class R>
+    static bool less(const L& lhs, const R& rhs);
+
+  private:
+    // equal keys are told apart by address, which gives every node a place of
+    // its own that's the same on every level.
+    static bool before(const skiplist_node* lhs, const skiplist_node* rhs);
+
+    ////////////
+    // Links. //
+    ////////////
+
+  private:
+    // the lowest bit of a link out of a node marks the node as on its way out,
+    // which also keeps anyone from linking anything in after it.
+    static constexpr uintptr_t marked = 1;
+
+    std::atomic<uintptr_t> _links[Height];
+    uint64_t _height;
+
+    static skiplist_node* target(uintptr_t link);
+    static uintptr_t link(const skiplist_node* node);
+
+    bool removed() const;
+  };
+
+} // namespace hatch
+
+#endif // HATCH_SKIPLIST_NODE_HH
@@ -0,0 +1,85 @@
+#ifndef HATCH_SKIPLIST_NODE_IMPL_HH
+#define HATCH_SKIPLIST_NODE_IMPL_HH
+
+#ifndef HATCH_SKIPLIST_HH
+#error "do not include skiplist_node_impl.hh directly. include skiplist.hh instead."
+#endif
+
+#include <functional> // std::less
+#include <utility> // std::forward
+
+namespace hatch {
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  template <class ...Args>
+  skiplist_node<T, KeyOf, Compare, Height>::skiplist_node(Args&&... args) :
+      container<T>::container{std::forward<Args>(args)...},
+      _links{},
+      _height{0} {
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_node<T, KeyOf, Compare, Height>::~skiplist_node() {
+  }
+
+  ///////////
+  // Keys. //
+  ///////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  T& skiplist_node<T, KeyOf, Compare, Height>::get() const {
+    if constexpr (complete<T>) {
+      return container<T>::get();
+    } else {
+      return const_cast<T&>(static_cast<const T&>(*this));
+    }
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  decltype(auto) skiplist_node<T, KeyOf, Compare, Height>::key() const {
+    return KeyOf{}(get());
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  template <class L, class R>
+  bool skiplist_node<T, KeyOf, Compare, Height>::less(const L& lhs, const R& rhs) {
+    return Compare{}(lhs, rhs);
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  bool skiplist_node<T, KeyOf, Compare, Height>::before(const skiplist_node* lhs, const skiplist_node* rhs) {
+    if (less(lhs->key(), rhs->key())) {
+      return true;
+    } else if (less(rhs->key(), lhs->key())) {
+      return false;
+    } else {
+      return std::less<const skiplist_node*>{}(lhs, rhs);
+    }
+  }
+
+  ////////////
+  // Links. //
+  ////////////
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  skiplist_node<T, KeyOf, Compare, Height>* skiplist_node<T, KeyOf, Compare, Height>::target(uintptr_t link) {
+    return reinterpret_cast<skiplist_node*>(link & ~marked);
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  uintptr_t skiplist_node<T, KeyOf, Compare, Height>::link(const skiplist_node* node) {
+    return reinterpret_cast<uintptr_t>(node);
+  }
+
+  template <class T, class KeyOf, class Compare, uint64_t Height>
+  bool skiplist_node<T, KeyOf, Compare, Height>::removed() const {
+    return _links[0].load(std::memory_order_acquire) & marked;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_SKIPLIST_NODE_IMPL_HH
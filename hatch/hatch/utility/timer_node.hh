@@ -0,0 +1,51 @@
+#ifndef HATCH_TIMER_NODE_HH
+#define HATCH_TIMER_NODE_HH
+
+#ifndef HATCH_TIMER_WHEEL_HH
+#error "do not include timer_node.hh directly. include timer_wheel.hh instead."
+#endif
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  template <class T>
+  class timer_node : public list_node<T> {
+  public:
+    template <class, uint64_t, uint64_t>
+    friend class timer_wheel;
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    template <class ...Args>
+    explicit timer_node(Args&&... args);
+    ~timer_node();
+
+    // the wheel keeps track of timers by where they are.
+    timer_node(timer_node&&) = delete;
+    timer_node& operator=(timer_node&&) = delete;
+
+    timer_node(const timer_node&) = delete;
+    timer_node& operator=(const timer_node&) = delete;
+
+    ////////////
+    // Timer. //
+    ////////////
+
+  private:
+    uint64_t _deadline;
+
+    // the slot the timer is waiting in, if it's armed.
+    list<T>* _slot;
+
+  public:
+    bool armed() const;
+    uint64_t deadline() const;
+  };
+
+} // namespace hatch
+
+#endif // HATCH_TIMER_NODE_HH
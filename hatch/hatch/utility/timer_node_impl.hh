@@ -0,0 +1,49 @@
+#ifndef HATCH_TIMER_NODE_IMPL_HH
+#define HATCH_TIMER_NODE_IMPL_HH
+
+#ifndef HATCH_TIMER_WHEEL_HH
+#error "do not include timer_node_impl.hh directly. include timer_wheel.hh instead."
+#endif
+
+#include <utility> // std::forward
+
+namespace hatch {
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T>
+  template <class ...Args>
+  timer_node<T>::timer_node(Args&&... args) :
+      list_node<T>{std::forward<Args>(args)...},
+      _deadline{0},
+      _slot{nullptr} {
+  }
+
+  template <class T>
+  timer_node<T>::~timer_node() {
+    // a timer that goes away while armed just drops out of its slot.
+    if (_slot) {
+      _slot->remove(*this);
+      _slot = nullptr;
+    }
+  }
+
+  ////////////
+  // Timer. //
+  ////////////
+
+  template <class T>
+  bool timer_node<T>::armed() const {
+    return _slot;
+  }
+
+  template <class T>
+  uint64_t timer_node<T>::deadline() const {
+    return _deadline;
+  }
+
+} // namespace hatch
+
+#endif // HATCH_TIMER_NODE_IMPL_HH
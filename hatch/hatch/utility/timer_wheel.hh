@@ -0,0 +1,89 @@
+#ifndef HATCH_TIMER_WHEEL_HH
+#define HATCH_TIMER_WHEEL_HH
+
+#include <hatch/utility/timer_wheel_fwd.hh>
+#include <hatch/utility/list.hh>
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  // a hierarchy of wheels of timers, counted in ticks. each wheel has a list
+  // of timers for every one of its slots, and a slot on one wheel spans a whole
+  // turn of the wheel below it. a timer goes on the lowest wheel that's still
+  // turning toward its deadline. when a lower wheel comes around to zero, the
+  // next slot of the wheel above is emptied onto the wheels below.
+  //
+  // arming and cancelling a timer is just a list push and unlink, which is
+  // all most timers ever see: they're cancelled long before they'd fire.
+  template <class T, uint64_t Bits, uint64_t Levels>
+  class timer_wheel final {
+  public:
+    static_assert(Bits > 0 && Levels > 0 && Bits * Levels < 64, "a timer wheel has to span less than the whole range of ticks.");
+
+    ///////////////////////////////
+    // Constructors, destructor. //
+    ///////////////////////////////
+
+  public:
+    explicit timer_wheel(uint64_t now = 0);
+    ~timer_wheel();
+
+    timer_wheel(timer_wheel&&) = delete;
+    timer_wheel& operator=(timer_wheel&&) = delete;
+
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+    ////////////////
+    // Structure. //
+    ////////////////
+
+  private:
+    static constexpr uint64_t slots = uint64_t{1} << Bits;
+    static constexpr uint64_t mask = slots - 1;
+
+    // the last tick that's been handled.
+    uint64_t _now;
+    list<T> _wheels[Levels][slots];
+
+    void place(timer_node<T>& timer);
+    void cascade(uint64_t level, uint64_t tick);
+
+    template <class Fire>
+    void tick(Fire& fire);
+
+    //////////////////////////
+    // Structure: accessors //
+    //////////////////////////
+
+  public:
+    uint64_t now() const;
+
+    /////////////////////////
+    // Structure: mutators //
+    /////////////////////////
+
+  public:
+    // a deadline that has already passed fires on the next tick. arming a timer
+    // that's already armed moves it.
+    void arm(timer_node<T>& timer, uint64_t deadline);
+    T* cancel(timer_node<T>& timer);
+
+    // handles every tick up to and including now, calling fire on each timer
+    // as it comes due. fire is free to arm or cancel any timer, including the
+    // one it was called for.
+    template <class Fire>
+    void advance(uint64_t now, Fire fire);
+
+    void clear();
+  };
+
+} // namespace hatch
+
+#include <hatch/utility/timer_node.hh>
+
+#include <hatch/utility/timer_wheel_impl.hh>
+#include <hatch/utility/timer_node_impl.hh>
+
+#endif // HATCH_TIMER_WHEEL_HH
@@ -0,0 +1,18 @@
+#ifndef HATCH_TIMER_WHEEL_FWD_HH
+#define HATCH_TIMER_WHEEL_FWD_HH
+
+#include <hatch/utility/list_fwd.hh>
+
+#include <cstdint> // uint64_t
+
+namespace hatch {
+
+  template <class T, uint64_t Bits = 6, uint64_t Levels = 4>
+  class timer_wheel;
+
+  template <class T>
+  class timer_node;
+
+} // namespace hatch
+
+#endif // HATCH_TIMER_WHEEL_FWD_HH
@@ -0,0 +1,144 @@
+#ifndef HATCH_TIMER_WHEEL_IMPL_HH
+#define HATCH_TIMER_WHEEL_IMPL_HH
+
+#ifndef HATCH_TIMER_WHEEL_HH
+#error "do not include timer_wheel_impl.hh directly. include timer_wheel.hh instead."
+#endif
+
+#include <algorithm> // std::max
+#include <type_traits> // std::is_base_of_v
+
+namespace hatch {
+
+  ///////////////////////////////
+  // Constructors, destructor. //
+  ///////////////////////////////
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  timer_wheel<T, Bits, Levels>::timer_wheel(uint64_t now) :
+      _now{now},
+      _wheels{} {
+  }
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  timer_wheel<T, Bits, Levels>::~timer_wheel() {
+    clear();
+  }
+
+  ////////////////
+  // Structure. //
+  ////////////////
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  void timer_wheel<T, Bits, Levels>::place(timer_node<T>& timer) {
+    static_assert(std::is_base_of_v<timer_node<T>, T>, "timers have to derive from their nodes to be found again in their slots.");
+
+    // the lowest wheel on which the deadline is still ahead within the current
+    // turn of the wheel above. past the top wheel, a timer just goes around the
+    // top until it's close enough.
+    auto next = _now + 1;
+    auto deadline = std::max(timer._deadline, next);
+
+    auto level = 0lu;
+    while (level + 1 < Levels && (deadline >> (Bits * (level + 1))) != (next >> (Bits * (level + 1)))) {
+      level++;
+    }
+
+    auto& slot = _wheels[level][(deadline >> (Bits * level)) & mask];
+    slot.push_back(timer);
+    timer._slot = &slot;
+  }
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  void timer_wheel<T, Bits, Levels>::cascade(uint64_t level, uint64_t tick) {
+    // everything in the slot is due within the turn of the wheel below that
+    // starts now, so it all lands lower down. the slot is emptied first, since
+    // a timer going around the top can come right back into it.
+    list<T> waiting;
+    waiting.push_back(_wheels[level][(tick >> (Bits * level)) & mask]);
+    while (auto* timer = waiting.pop_front()) {
+      place(*timer);
+    }
+  }
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  template <class Fire>
+  void timer_wheel<T, Bits, Levels>::tick(Fire& fire) {
+    auto tick = _now + 1;
+
+    // every wheel that comes around to zero on this tick pulls down its next
+    // slot, from the top down so that timers can fall more than one wheel.
+    auto turned = 1lu;
+    while (turned < Levels && (tick & ((uint64_t{1} << (Bits * turned)) - 1)) == 0) {
+      turned++;
+    }
+    for (auto level = turned; level-- > 1;) {
+      cascade(level, tick);
+    }
+
+    // the slot is emptied before anything fires, since a timer armed again a
+    // whole turn from now goes right back into it. the timers still waiting
+    // to fire are moved along with it, so that they can be cancelled there.
+    _now = tick;
+    list<T> due;
+    due.push_back(_wheels[0][tick & mask]);
+    for (auto& timer : due) {
+      timer._slot = &due;
+    }
+    while (auto* timer = due.pop_front()) {
+      timer->_slot = nullptr;
+      fire(*timer);
+    }
+  }
+
+  //////////////////////////
+  // Structure: accessors //
+  //////////////////////////
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  uint64_t timer_wheel<T, Bits, Levels>::now() const {
+    return _now;
+  }
+
+  /////////////////////////
+  // Structure: mutators //
+  /////////////////////////
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  void timer_wheel<T, Bits, Levels>::arm(timer_node<T>& timer, uint64_t deadline) {
+    cancel(timer);
+    timer._deadline = deadline;
+    place(timer);
+  }
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  T* timer_wheel<T, Bits, Levels>::cancel(timer_node<T>& timer) {
+    if (timer._slot) {
+      timer._slot->remove(timer);
+      timer._slot = nullptr;
+    }
+    return &timer.get();
+  }
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  template <class Fire>
+  void timer_wheel<T, Bits, Levels>::advance(uint64_t now, Fire fire) {
+    while (_now < now) {
+      tick(fire);
+    }
+  }
+
+  template <class T, uint64_t Bits, uint64_t Levels>
+  void timer_wheel<T, Bits, Levels>::clear() {
+    for (auto& wheel : _wheels) {
+      for (auto& slot : wheel) {
+        while (auto* timer = slot.pop_front()) {
+          timer->_slot = nullptr;
+        }
+      }
+    }
+  }
+
+} // namespace hatch
+
+#endif // HATCH_TIMER_WHEEL_IMPL_HH
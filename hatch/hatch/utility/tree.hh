@@ -4,22 +4,29 @@
 #include <hatch/utility/tree_fwd.hh>
 
 #include <hatch/utility/indexed.hh>
+#include <hatch/utility/marked.hh>
 #include <hatch/utility/pointed.hh>
 #include <hatch/utility/owning.hh>
 
+#include <cstdint> // uint64_t
+#include <type_traits> // std::enable_if_t, std::is_base_of_v
+#include <utility> // std::pair
+#include <vector> // std::vector
+
 namespace hatch {
 
-  template <class T, template <class> class Ref>
-  class tree final : public owner<tree<T, Ref>, tree_iterator<T, Ref>> {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  class tree final : public owner<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> {
   public:
-    friend class tree_iterator<T, Ref>;
+    friend class tree_iterator<T, Ref, KeyOf, Compare, Augment>;
+    friend class concurrent_tree<T, KeyOf, Compare, Augment>;
 
     ///////////////////////////////////////////
     // Constructors, destructor, assignment. //
     ///////////////////////////////////////////
 
   protected:
-    explicit tree(Ref<tree_node<T, Ref>> root, void* data);
+    explicit tree(tree_node<T, Ref, KeyOf, Compare, Augment>* root);
 
   public:
     tree();
@@ -36,83 +43,84 @@ namespace hatch {
     ////////////////
 
   public:
-    tree_iterator<T, Ref> begin();
-    const tree_iterator<T, Ref> begin() const;
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> begin();
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> begin() const;
 
-    tree_iterator<T, Ref> end();
-    const tree_iterator<T, Ref> end() const;
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> end();
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> end() const;
 
-    tree_iterator<T, Ref> find(const tree_node<T, Ref>& node);
-    const tree_iterator<T, Ref> find(const tree_node<T, Ref>& node) const;
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> find(const tree_node<T, Ref, KeyOf, Compare, Augment>& node);
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> find(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const;
 
-    ////////////////
-    // Structure. //
-    ////////////////
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> find(const K& key);
 
-  private:
-    Ref<tree_node<T, Ref>> _root;
-    void* _data;
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> find(const K& key) const;
 
-    //////////////////////////
-    // Structure: accessors //
-    //////////////////////////
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> lower_bound(const tree_node<T, Ref, KeyOf, Compare, Augment>& node);
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> lower_bound(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const;
 
-  public:
-    bool empty() const;
-    T* root() const;
-    T* minimum() const;
-    T* maximum() const;
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> lower_bound(const K& key);
 
-    /////////////////////////
-    // Structure: mutators //
-    /////////////////////////
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> lower_bound(const K& key) const;
 
-  public:
-    tree_iterator<T, Ref> insert(tree_node<T, Ref>& node);
-  };
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> upper_bound(const tree_node<T, Ref, KeyOf, Compare, Augment>& node);
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> upper_bound(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const;
 
-  template <class T>
-  class tree<T, pointed> final : public owner<tree<T, pointed>, tree_iterator<T, pointed>> {
-  public:
-    friend class tree_iterator<T, pointed>;
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> upper_bound(const K& key);
 
-    ///////////////////////////////////////////
-    // Constructors, destructor, assignment. //
-    ///////////////////////////////////////////
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> upper_bound(const K& key) const;
 
-  protected:
-    explicit tree(pointed<tree_node<T, pointed>> root);
+    std::pair<tree_iterator<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> equal_range(const tree_node<T, Ref, KeyOf, Compare, Augment>& node);
+    const std::pair<tree_iterator<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> equal_range(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const;
 
-  public:
-    tree();
-    ~tree();
-
-    tree(tree&& moved) noexcept;
-    tree& operator=(tree&& moved) noexcept;
-
-    tree(const tree&) = delete;
-    tree& operator=(const tree&) = delete;
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    std::pair<tree_iterator<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> equal_range(const K& key);
 
-    ////////////////
-    // Iterators. //
-    ////////////////
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    const std::pair<tree_iterator<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> equal_range(const K& key) const;
 
-  public:
-    tree_iterator<T, pointed> begin();
-    const tree_iterator<T, pointed> begin() const;
+    // with sized nodes, the tree can also be indexed by position in its order.
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> select(uint64_t index);
+    const tree_iterator<T, Ref, KeyOf, Compare, Augment> select(uint64_t index) const;
 
-    tree_iterator<T, pointed> end();
-    const tree_iterator<T, pointed> end() const;
+    // calls visit on every node, in order, except for the subtrees whose
+    // summaries enter turns down. with a summary that bounds its subtree, that
+    // only touches the parts of the tree that can hold anything of interest.
+    template <class Enter, class Visit>
+    void visit(Enter enter, Visit visit);
 
-    tree_iterator<T, pointed> find(const tree_node<T, pointed>& node);
-    const tree_iterator<T, pointed> find(const tree_node<T, pointed>& node) const;
+    template <class Enter, class Visit>
+    void visit(Enter enter, Visit visit) const;
 
     ////////////////
     // Structure. //
     ////////////////
 
   private:
-    pointed<tree_node<T, pointed>> _root;
+    Ref<tree_node<T, Ref, KeyOf, Compare, Augment>> _root;
+
+    template <class K>
+    tree_node<T, Ref, KeyOf, Compare, Augment>* search(const K& key);
+
+    template <class K>
+    tree_node<T, Ref, KeyOf, Compare, Augment>* lower(const K& key);
+
+    template <class K>
+    tree_node<T, Ref, KeyOf, Compare, Augment>* upper(const K& key);
+
+    template <class K>
+    std::pair<tree, tree> divide(const K& key);
+
+    static tree_node<T, Ref, KeyOf, Compare, Augment>* build(tree_node<T, Ref, KeyOf, Compare, Augment>** nodes, uint64_t count, uint64_t depth, uint64_t red);
+
+    template <class Enter, class Visit>
+    static void descend(tree_node<T, Ref, KeyOf, Compare, Augment>* node, Enter& enter, Visit& visit);
 
     //////////////////////////
     // Structure: accessors //
@@ -124,12 +132,32 @@ namespace hatch {
     T* minimum() const;
     T* maximum() const;
 
+    uint64_t size() const;
+    uint64_t rank(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const;
+
     /////////////////////////
     // Structure: mutators //
     /////////////////////////
 
   public:
-    tree_iterator<T, pointed> insert(tree_node<T, pointed>& node);
+    tree_iterator<T, Ref, KeyOf, Compare, Augment> insert(tree_node<T, Ref, KeyOf, Compare, Augment>& node);
+    T* remove(tree_node<T, Ref, KeyOf, Compare, Augment>& node);
+    void clear();
+
+    // replaces the contents with nodes that are already in order and not in any
+    // tree, in linear time rather than one insertion after another.
+    template <class Iterator>
+    void assign_sorted(Iterator first, Iterator last);
+
+    // splits off everything ordered before the key into the first tree and the
+    // rest into the second, leaving this tree empty.
+    std::pair<tree, tree> split(const tree_node<T, Ref, KeyOf, Compare, Augment>& node);
+
+    template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool> = true>
+    std::pair<tree, tree> split(const K& key);
+
+    // everything in lower has to be ordered no later than everything in upper.
+    static tree join(tree&& lower, tree&& upper);
   };
 
 } // namespace hatch
@@ -3,18 +3,80 @@
 
 #include <hatch/utility/pointed.hh>
 
+#include <algorithm> // std::min, std::max
+#include <functional> // std::less
+#include <initializer_list> // std::initializer_list
+
+#include <cstdint> // uint64_t
+
 namespace hatch {
 
-  template <class T, template <class> class Ref = pointed>
+  // unless told otherwise, a tree orders its nodes by their whole payload.
+  class identity {
+  public:
+    template <class T>
+    const T& operator()(const T& value) const {
+      return value;
+    }
+  };
+
+  // an augmentation is kept in every node and summarizes the subtree below it.
+  // whenever the shape under a node changes, the node summarizes itself again
+  // from its own payload and the summaries of its children, so the summaries
+  // only have to be composable.
+  class unaugmented {
+  public:
+    template <class T>
+    void summarize(const T&, const unaugmented*, const unaugmented*) {
+    }
+  };
+
+  // the number of nodes in the subtree, which is enough to find a node by its
+  // position or a position by its node.
+  class sized {
+  public:
+    template <class T>
+    void summarize(const T& value, const sized* prev, const sized* next) {
+      _size = 1 + (prev ? prev->_size : 0) + (next ? next->_size : 0);
+    }
+
+    uint64_t _size{1};
+  };
+
+  // the least low and the greatest high in the subtree. with the interval
+  // starts as the keys and their ends as the highs, that's an interval tree; a
+  // subtree can only overlap a range if its span does.
+  template <class V, class LowOf, class HighOf = LowOf>
+  class spanned {
+  public:
+    template <class T>
+    void summarize(const T& value, const spanned* prev, const spanned* next) {
+      _low = LowOf{}(value);
+      _high = HighOf{}(value);
+      for (auto* child : {prev, next}) {
+        if (child) {
+          _low = std::min(_low, child->_low);
+          _high = std::max(_high, child->_high);
+        }
+      }
+    }
+
+    V _low{};
+    V _high{};
+  };
+
+  template <class T, template <class> class Ref = pointed, class KeyOf = identity, class Compare = std::less<>, class Augment = unaugmented>
   class tree;
 
-  template <class T, template <class> class Ref = pointed>
+  template <class T, template <class> class Ref = pointed, class KeyOf = identity, class Compare = std::less<>, class Augment = unaugmented>
   class tree_node;
 
-  template <class T, template <class> class Ref = pointed>
+  template <class T, template <class> class Ref = pointed, class KeyOf = identity, class Compare = std::less<>, class Augment = unaugmented>
   class tree_iterator;
 
+  template <class T, class KeyOf = identity, class Compare = std::less<>, class Augment = unaugmented>
+  class concurrent_tree;
+
 } // namespace hatch
 
 #endif // HATCH_TREE_FWD_HH
-
@@ -13,114 +13,457 @@ namespace hatch {
   // Constructors, destructor, assignment. //
   ///////////////////////////////////////////
 
-  template<class T, template <class> class Ref>
-  tree<T, Ref>::tree(Ref<tree_node<T, Ref>> root, void* data) :
-      _root{root},
-      _data{data} {
-  }
-
-  template<class T, template <class> class Ref>
-  tree<T, Ref>::tree() :
-    _root{},
-    _data{nullptr} {
-  }
-
-  template<class T, template <class> class Ref>
-  tree<T, Ref>::~tree() {
-    while(_root) {
-      auto* min = _root->minimum(_data);
-      auto* max = _root->maximum(_data);
-      if (min != _root) {
-        min->remove(_data);
-      } else if (max != _root) {
-        max->remove(_data);
-      } else {
-        _root = nullptr;
-      }
-    }
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree<T, Ref, KeyOf, Compare, Augment>::tree(tree_node<T, Ref, KeyOf, Compare, Augment>* root) :
+      _root{root} {
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree<T, Ref, KeyOf, Compare, Augment>::tree() :
+      _root{} {
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree<T, Ref, KeyOf, Compare, Augment>::~tree() {
+    clear();
   }
 
-  template<class T, template <class> class Ref>
-  tree<T, Ref>::tree(tree&& moved) noexcept :
-      owner<tree<T>, tree_iterator<T>>::owner{std::move(moved)},
-      _root{moved._root},
-      _data{moved._data} {
-    moved._root = Ref<tree_node<T, Ref>>{};
-    moved._data = nullptr;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree<T, Ref, KeyOf, Compare, Augment>::tree(tree&& moved) noexcept :
+      owner<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>>::owner{std::move(moved)},
+      _root{moved._root} {
+    moved._root = nullptr;
   }
 
-  template<class T, template <class> class Ref>
-  tree<T, Ref>& tree<T, Ref>::operator=(tree&& moved) noexcept {
-    owner<tree<T>, tree_iterator<T>>::operator=(std::move(moved));
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree<T, Ref, KeyOf, Compare, Augment>& tree<T, Ref, KeyOf, Compare, Augment>::operator=(tree&& moved) noexcept {
+    clear();
+    owner<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>>::operator=(std::move(moved));
     _root = moved._root;
-    _data = moved._data;
-    moved._root = Ref<tree_node<T, Ref>>{};
-    moved._data = nullptr;
+    moved._root = nullptr;
+    return *this;
   }
 
   ////////////////
   // Iterators. //
   ////////////////
 
-  template<class T, template <class> class Ref>
-  tree_iterator<T, Ref> tree<T, Ref>::begin() {
-    return tree_iterator<T, Ref>{this, _root ? minimum() : tree_iterator<T, Ref>::_after};
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::begin() {
+    return tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, _root ? _root->minimum() : tree_iterator<T, Ref, KeyOf, Compare, Augment>::_after};
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::begin() const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).begin();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::end() {
+    return tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, tree_iterator<T, Ref, KeyOf, Compare, Augment>::_after};
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::end() const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).end();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::find(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) {
+    auto* found = search(node.key());
+    return found ? tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, found} : end();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::find(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).find(node);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::find(const K& key) {
+    auto* found = search(key);
+    return found ? tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, found} : end();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::find(const K& key) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).find(key);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree<T, Ref, KeyOf, Compare, Augment>::search(const K& key) {
+    // the key only has to be comparable with the keys of the nodes, so there's
+    // no need to build a node just to look one up.
+    auto* current = _root ? &*_root : nullptr;
+    while (current) {
+      if (current->less(key, current->key())) {
+        current = current->prev();
+      } else if (current->less(current->key(), key)) {
+        current = current->next();
+      } else {
+        return current;
+      }
+    }
+    return nullptr;
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::lower_bound(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) {
+    auto* found = lower(node.key());
+    return found ? tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, found} : end();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::lower_bound(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).lower_bound(node);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::lower_bound(const K& key) {
+    auto* found = lower(key);
+    return found ? tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, found} : end();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::lower_bound(const K& key) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).lower_bound(key);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::upper_bound(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) {
+    auto* found = upper(node.key());
+    return found ? tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, found} : end();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::upper_bound(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).upper_bound(node);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::upper_bound(const K& key) {
+    auto* found = upper(key);
+    return found ? tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, found} : end();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::upper_bound(const K& key) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).upper_bound(key);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  std::pair<tree_iterator<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> tree<T, Ref, KeyOf, Compare, Augment>::equal_range(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) {
+    return {lower_bound(node), upper_bound(node)};
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const std::pair<tree_iterator<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> tree<T, Ref, KeyOf, Compare, Augment>::equal_range(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).equal_range(node);
   }
 
-  template<class T, template <class> class Ref>
-  const tree_iterator<T, Ref> tree<T, Ref>::begin() const {
-    return const_cast<tree<T, Ref>&>(*this).begin();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  std::pair<tree_iterator<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> tree<T, Ref, KeyOf, Compare, Augment>::equal_range(const K& key) {
+    return {lower_bound(key), upper_bound(key)};
   }
 
-  template<class T, template <class> class Ref>
-  tree_iterator<T, Ref> tree<T, Ref>::end() {
-    return tree_iterator<T, Ref>{this, tree_iterator<T, Ref>::_after};
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  const std::pair<tree_iterator<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> tree<T, Ref, KeyOf, Compare, Augment>::equal_range(const K& key) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).equal_range(key);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree<T, Ref, KeyOf, Compare, Augment>::lower(const K& key) {
+    // the leftmost node whose key isn't ordered before the key we're given.
+    tree_node<T, Ref, KeyOf, Compare, Augment>* bound = nullptr;
+    auto* current = _root ? &*_root : nullptr;
+    while (current) {
+      if (current->less(current->key(), key)) {
+        current = current->next();
+      } else {
+        bound = current;
+        current = current->prev();
+      }
+    }
+    return bound;
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree<T, Ref, KeyOf, Compare, Augment>::upper(const K& key) {
+    // the leftmost node whose key is ordered after the key we're given.
+    tree_node<T, Ref, KeyOf, Compare, Augment>* bound = nullptr;
+    auto* current = _root ? &*_root : nullptr;
+    while (current) {
+      if (current->less(key, current->key())) {
+        bound = current;
+        current = current->prev();
+      } else {
+        current = current->next();
+      }
+    }
+    return bound;
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::select(uint64_t index) {
+    static_assert(std::is_base_of_v<sized, Augment>, "only trees of sized nodes can be indexed.");
+
+    // the size of the prev subtree is the number of nodes ordered before the
+    // current one, so every step either lands on the node or skips a subtree.
+    auto* current = _root ? &*_root : nullptr;
+    while (current) {
+      auto* prev = current->prev();
+      auto before = prev ? prev->summary()._size : 0;
+      if (index < before) {
+        current = prev;
+      } else if (index == before) {
+        return tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, current};
+      } else {
+        index -= before + 1;
+        current = current->next();
+      }
+    }
+    return end();
   }
 
-  template<class T, template <class> class Ref>
-  const tree_iterator<T, Ref> tree<T, Ref>::end() const {
-    return const_cast<tree<T, Ref>&>(*this).end();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::select(uint64_t index) const {
+    return const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).select(index);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class Enter, class Visit>
+  void tree<T, Ref, KeyOf, Compare, Augment>::visit(Enter enter, Visit visit) {
+    descend(_root ? &*_root : nullptr, enter, visit);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class Enter, class Visit>
+  void tree<T, Ref, KeyOf, Compare, Augment>::visit(Enter enter, Visit visit) const {
+    const_cast<tree<T, Ref, KeyOf, Compare, Augment>&>(*this).visit(enter, [&visit](const T& value) {
+      visit(value);
+    });
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class Enter, class Visit>
+  void tree<T, Ref, KeyOf, Compare, Augment>::descend(tree_node<T, Ref, KeyOf, Compare, Augment>* node, Enter& enter, Visit& visit) {
+    // the recursion only goes as deep as the tree, which is logarithmic.
+    if (node && enter(node->summary())) {
+      descend(node->prev(), enter, visit);
+      visit(node->get());
+      descend(node->next(), enter, visit);
+    }
   }
 
   //////////////////////////
   // Structure: accessors //
   //////////////////////////
 
-  template<class T, template <class> class Ref>
-  bool tree<T, Ref>::empty() const {
-    return _root;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree<T, Ref, KeyOf, Compare, Augment>::empty() const {
+    return !_root;
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  T* tree<T, Ref, KeyOf, Compare, Augment>::root() const {
+    return _root ? &_root->get() : nullptr;
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  T* tree<T, Ref, KeyOf, Compare, Augment>::minimum() const {
+    return _root ? &_root->minimum()->get() : nullptr;
   }
 
-  template<class T, template <class> class Ref>
-  T* tree<T, Ref>::root() const {
-    return _root ? &_root.get(_data)->get() : nullptr;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  T* tree<T, Ref, KeyOf, Compare, Augment>::maximum() const {
+    return _root ? &_root->maximum()->get() : nullptr;
   }
 
-  template<class T, template <class> class Ref>
-  T* tree<T, Ref>::minimum() const {
-    return _root ? &_root.get(_data)->minimum(_data)->get() : nullptr;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  uint64_t tree<T, Ref, KeyOf, Compare, Augment>::size() const {
+    static_assert(std::is_base_of_v<sized, Augment>, "only trees of sized nodes know their size.");
+    return _root ? _root->summary()._size : 0;
   }
 
-  template<class T, template <class> class Ref>
-  T* tree<T, Ref>::maximum() const {
-    return _root ? &_root.get(_data)->maximum(_data)->get() : nullptr;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  uint64_t tree<T, Ref, KeyOf, Compare, Augment>::rank(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) const {
+    static_assert(std::is_base_of_v<sized, Augment>, "only trees of sized nodes can be indexed.");
+
+    // everything in the prev subtree comes first, and then, on the way up,
+    // every head we reach from its next side comes first along with its own
+    // prev subtree.
+    auto* prev = node.prev();
+    auto rank = prev ? prev->summary()._size : 0;
+    for (auto* current = &node; current->head(); current = current->head()) {
+      if (current->is_next()) {
+        auto* before = current->head()->prev();
+        rank += 1 + (before ? before->summary()._size : 0);
+      }
+    }
+    return rank;
   }
 
   /////////////////////////
   // Structure: mutators //
   /////////////////////////
 
-  template<class T, template <class> class Ref>
-  tree_iterator<T, Ref> tree<T, Ref>::insert(tree_node<T, Ref>& node) {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::insert(tree_node<T, Ref, KeyOf, Compare, Augment>& node) {
     this->disown_all();
     if (_root) {
-      _root->insert(node, _data);
+      _root->insert(node);
+      _root = _root->root();
     } else {
+      node.make_black();
+      node.refresh();
       _root = &node;
     }
-    _root = Ref<tree_node<T, Ref>>{_root->root(_data), _data};
-    return tree_iterator<T, Ref>{this, &node};
+    return tree_iterator<T, Ref, KeyOf, Compare, Augment>{this, &node};
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  T* tree<T, Ref, KeyOf, Compare, Augment>::remove(tree_node<T, Ref, KeyOf, Compare, Augment>& node) {
+    this->disown_all();
+
+    // any other node of the tree survives the removal, so we can find the new
+    // root from it once the rebalancing is done.
+    auto* other = node.predecessor();
+    if (!other) {
+      other = node.successor();
+    }
+
+    node.remove();
+
+    if (other) {
+      _root = other->root();
+    } else {
+      _root = nullptr;
+    }
+
+    return &node.get();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree<T, Ref, KeyOf, Compare, Augment>::clear() {
+    this->disown_all();
+
+    // no need to rebalance anything on the way out; just strip the leaves off
+    // one at a time until the root itself is a leaf.
+    auto* node = _root ? &*_root : nullptr;
+    while (node) {
+      if (auto* prev = node->prev()) {
+        node = prev;
+      } else if (auto* next = node->next()) {
+        node = next;
+      } else {
+        auto* head = node->head();
+        node->detach();
+        node = head;
+      }
+    }
+    _root = nullptr;
   }
-}
 
-#endif
\ No newline at end of file
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class Iterator>
+  void tree<T, Ref, KeyOf, Compare, Augment>::assign_sorted(Iterator first, Iterator last) {
+    clear();
+
+    std::vector<tree_node<T, Ref, KeyOf, Compare, Augment>*> nodes;
+    for (; first != last; ++first) {
+      tree_node<T, Ref, KeyOf, Compare, Augment>& node = *first;
+      nodes.push_back(&node);
+    }
+
+    if (!nodes.empty()) {
+      // splitting at the middle fills every level but the deepest, so making
+      // just the deepest level red gives every path the same black height.
+      auto red = 0lu;
+      for (auto count = nodes.size(); count > 1; count >>= 1) {
+        red++;
+      }
+      _root = build(nodes.data(), nodes.size(), 0, red);
+    }
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree<T, Ref, KeyOf, Compare, Augment>::build(tree_node<T, Ref, KeyOf, Compare, Augment>** nodes, uint64_t count, uint64_t depth, uint64_t red) {
+    if (!count) {
+      return nullptr;
+    }
+
+    auto middle = count / 2;
+    auto* node = nodes[middle];
+    node->make_child(build(nodes, middle, depth + 1, red), tree_node<T, Ref, KeyOf, Compare, Augment>::sides::prev);
+    node->make_child(build(nodes + middle + 1, count - middle - 1, depth + 1, red), tree_node<T, Ref, KeyOf, Compare, Augment>::sides::next);
+    if (depth > 0 && depth == red) {
+      node->make_red();
+    } else {
+      node->make_black();
+    }
+    node->refresh();
+    return node;
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  std::pair<tree<T, Ref, KeyOf, Compare, Augment>, tree<T, Ref, KeyOf, Compare, Augment>> tree<T, Ref, KeyOf, Compare, Augment>::split(const tree_node<T, Ref, KeyOf, Compare, Augment>& node) {
+    return divide(node.key());
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K, std::enable_if_t<!std::is_base_of_v<tree_node<T, Ref, KeyOf, Compare, Augment>, K>, bool>>
+  std::pair<tree<T, Ref, KeyOf, Compare, Augment>, tree<T, Ref, KeyOf, Compare, Augment>> tree<T, Ref, KeyOf, Compare, Augment>::split(const K& key) {
+    return divide(key);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K>
+  std::pair<tree<T, Ref, KeyOf, Compare, Augment>, tree<T, Ref, KeyOf, Compare, Augment>> tree<T, Ref, KeyOf, Compare, Augment>::divide(const K& key) {
+    this->disown_all();
+
+    auto* root = _root ? &*_root : nullptr;
+    _root = nullptr;
+
+    auto height = tree_node<T, Ref, KeyOf, Compare, Augment>::height(root);
+    auto [lower, upper] = tree_node<T, Ref, KeyOf, Compare, Augment>::split({root, height}, key);
+    return {tree{lower._root}, tree{upper._root}};
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree<T, Ref, KeyOf, Compare, Augment> tree<T, Ref, KeyOf, Compare, Augment>::join(tree&& lower, tree&& upper) {
+    if (upper.empty()) {
+      return std::move(lower);
+    }
+
+    // the least node of the upper tree is taken out to go between the two.
+    auto* pivot = upper._root->minimum();
+    upper.remove(*pivot);
+
+    lower.disown_all();
+    upper.disown_all();
+
+    auto* lower_root = lower._root ? &*lower._root : nullptr;
+    auto* upper_root = upper._root ? &*upper._root : nullptr;
+    lower._root = nullptr;
+    upper._root = nullptr;
+
+    auto lower_height = tree_node<T, Ref, KeyOf, Compare, Augment>::height(lower_root);
+    auto upper_height = tree_node<T, Ref, KeyOf, Compare, Augment>::height(upper_root);
+    auto joined = tree_node<T, Ref, KeyOf, Compare, Augment>::join({lower_root, lower_height}, pivot, {upper_root, upper_height});
+    return tree{joined._root};
+  }
+
+} // namespace hatch
+
+#endif // HATCH_TREE_IMPL_HH
@@ -9,17 +9,17 @@
 
 namespace hatch {
 
-  template <class T, template <class> class Ref>
-  class tree_iterator final : public owned<tree<T, Ref>, tree_iterator<T, Ref>> {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  class tree_iterator final : public owned<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>> {
   public:
-    friend class tree<T, Ref>;
+    friend class tree<T, Ref, KeyOf, Compare, Augment>;
 
     ///////////////////////////////////////////
     // Constructors, destructor, assignment. //
     ///////////////////////////////////////////
 
   private:
-    explicit tree_iterator(tree<T, Ref>* owner, tree_node<T, Ref>* node);
+    explicit tree_iterator(tree<T, Ref, KeyOf, Compare, Augment>* owner, tree_node<T, Ref, KeyOf, Compare, Augment>* node);
 
   public:
     tree_iterator();
@@ -34,7 +34,7 @@ namespace hatch {
     //////////////////
     // Comparisons. //
     //////////////////
-  
+
   public:
     operator bool() const;
     bool operator==(const tree_iterator& compared) const;
@@ -45,9 +45,9 @@ namespace hatch {
     ////////////////
 
   private:
-    mutable tree_node<T>* _node;
-    static tree_node<T>* _before;
-    static tree_node<T>* _after;
+    mutable tree_node<T, Ref, KeyOf, Compare, Augment>* _node;
+    static tree_node<T, Ref, KeyOf, Compare, Augment>* _before;
+    static tree_node<T, Ref, KeyOf, Compare, Augment>* _after;
 
     /////////////////////////////////////
     // Structure: get underlying data. //
@@ -75,7 +75,7 @@ namespace hatch {
     ////////////////////////////////////////
 
   public:
-    tree<T> remove();
+    tree<T, Ref, KeyOf, Compare, Augment> remove();
   };
 
 } // namespace hatch
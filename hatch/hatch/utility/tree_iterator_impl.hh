@@ -7,58 +7,58 @@
 
 namespace hatch {
 
-  template<class T>
-  tree_node<T>* tree_iterator<T>::_before =
-      const_cast<tree_node<T>*>(reinterpret_cast<const tree_node<T>*>("tree_iterator::before"));
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_iterator<T, Ref, KeyOf, Compare, Augment>::_before =
+      const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>*>(reinterpret_cast<const tree_node<T, Ref, KeyOf, Compare, Augment>*>("tree_iterator::before"));
 
-  template<class T>
-  tree_node<T>* tree_iterator<T>::_after =
-      const_cast<tree_node<T>*>(reinterpret_cast<const tree_node<T>*>("tree_iterator::after"));
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_iterator<T, Ref, KeyOf, Compare, Augment>::_after =
+      const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>*>(reinterpret_cast<const tree_node<T, Ref, KeyOf, Compare, Augment>*>("tree_iterator::after"));
 
   ///////////////////////////////////////////
   // Constructors, destructor, assignment. //
   ///////////////////////////////////////////
 
-  template<class T>
-  tree_iterator<T>::tree_iterator(tree<T>* owner, tree_node<T>* node) :
-      owned<tree<T>, tree_iterator<T>>::owned{owner},
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>::tree_iterator(tree<T, Ref, KeyOf, Compare, Augment>* owner, tree_node<T, Ref, KeyOf, Compare, Augment>* node) :
+      owned<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>>::owned{owner},
       _node{node} {
   }
 
-  template<class T>
-  tree_iterator<T>::tree_iterator() :
-      owned<tree<T>, tree_iterator<T>>::owned{},
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>::tree_iterator() :
+      owned<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>>::owned{},
     _node{nullptr} {
   }
 
-  template<class T>
-  tree_iterator<T>::~tree_iterator() {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>::~tree_iterator() {
   }
 
-  template<class T>
-  tree_iterator<T>::tree_iterator(tree_iterator&& moved) noexcept :
-      owned<tree<T>, tree_iterator<T>>::owned{std::move(moved)},
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>::tree_iterator(tree_iterator&& moved) noexcept :
+      owned<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>>::owned{std::move(moved)},
       _node{moved._node} {
     moved._node = nullptr;
   }
 
-  template<class T>
-  tree_iterator<T>& tree_iterator<T>::operator=(tree_iterator&& moved) noexcept {
-    owned<tree<T>, tree_iterator<T>>::operator=(std::move(moved));
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>& tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator=(tree_iterator&& moved) noexcept {
+    owned<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>>::operator=(std::move(moved));
     _node = moved._node;
     moved._node = nullptr;
     return *this;
   }
 
-  template<class T>
-  tree_iterator<T>::tree_iterator(const tree_iterator& copied) :
-      owned<tree<T>, tree_iterator<T>>::owned{copied},
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>::tree_iterator(const tree_iterator& copied) :
+      owned<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>>::owned{copied},
       _node{copied._node} {
   }
 
-  template<class T>
-  tree_iterator<T>& tree_iterator<T>::operator=(const tree_iterator& copied) {
-    owned<tree<T>, tree_iterator<T>>::operator=(copied);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>& tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator=(const tree_iterator& copied) {
+    owned<tree<T, Ref, KeyOf, Compare, Augment>, tree_iterator<T, Ref, KeyOf, Compare, Augment>>::operator=(copied);
     _node = copied._node;
     return *this;
   }
@@ -67,18 +67,18 @@ namespace hatch {
   // Comparisons. //
   //////////////////
 
-  template <class T>
-  tree_iterator<T>::operator bool() const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator bool() const {
     return this->_owner;
   }
 
-  template<class T>
-  bool tree_iterator<T>::operator==(const tree_iterator& compared) const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator==(const tree_iterator& compared) const {
     return this->_owner == compared._owner && _node == compared._node;
   }
 
-  template<class T>
-  bool tree_iterator<T>::operator!=(const tree_iterator& compared) const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator!=(const tree_iterator& compared) const {
     return this->_owner != compared._owner || _node != compared._node;
   }
 
@@ -86,13 +86,13 @@ namespace hatch {
   // Structure: get underlying data. //
   /////////////////////////////////////
 
-  template<class T>
-  T& tree_iterator<T>::operator*() const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  T& tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator*() const {
     return _node->get();
   }
 
-  template<class T>
-  T* tree_iterator<T>::operator->() const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  T* tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator->() const {
     return &_node->get();
   }
 
@@ -100,14 +100,14 @@ namespace hatch {
   // Structure: move iterator. //
   ///////////////////////////////
 
-  template<class T>
-  tree_iterator<T>& tree_iterator<T>::operator++() {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>& tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator++() {
     if (auto* tree = this->_owner) {
       if (_node == _before) {
-        if (tree->_root == nullptr) {
+        if (!tree->_root) {
           _node = _after;
         } else {
-          _node = tree->minimum();
+          _node = tree->_root->minimum();
         }
       } else if (_node != _after) {
         _node = _node->successor();
@@ -119,26 +119,26 @@ namespace hatch {
     return *this;
   }
 
-  template<class T>
-  const tree_iterator<T>& tree_iterator<T>::operator++() const {
-    return const_cast<tree_iterator<T>*>(this)->operator++();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment>& tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator++() const {
+    return const_cast<tree_iterator<T, Ref, KeyOf, Compare, Augment>*>(this)->operator++();
   }
 
-  template<class T>
-  const tree_iterator<T> tree_iterator<T>::operator++(int) const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator++(int) const {
     auto* const node = _node;
     this->operator++();
-    return {this->_owner, node};
+    return tree_iterator<T, Ref, KeyOf, Compare, Augment>{this->_owner, node};
   }
 
-  template<class T>
-  tree_iterator<T>& tree_iterator<T>::operator--() {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_iterator<T, Ref, KeyOf, Compare, Augment>& tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator--() {
     if (auto* tree = this->_owner) {
       if (_node == _after) {
-        if (tree->_root == nullptr) {
+        if (!tree->_root) {
           _node = _before;
         } else {
-          _node = tree->maximum();
+          _node = tree->_root->maximum();
         }
       } else if (_node != _before) {
         _node = _node->predecessor();
@@ -150,45 +150,32 @@ namespace hatch {
     return *this;
   }
 
-  template<class T>
-  const tree_iterator<T>& tree_iterator<T>::operator--() const {
-    return const_cast<tree_iterator<T>*>(this)->operator--();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment>& tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator--() const {
+    return const_cast<tree_iterator<T, Ref, KeyOf, Compare, Augment>*>(this)->operator--();
   }
 
-  template<class T>
-  const tree_iterator<T> tree_iterator<T>::operator--(int) const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_iterator<T, Ref, KeyOf, Compare, Augment> tree_iterator<T, Ref, KeyOf, Compare, Augment>::operator--(int) const {
     auto* const node = _node;
     this->operator--();
-    return {this->_owner, node};
+    return tree_iterator<T, Ref, KeyOf, Compare, Augment>{this->_owner, node};
   }
 
   ////////////////////////////////////////
   // Structure: mutate underlying tree. //
   ////////////////////////////////////////
 
-  template <class T>
-  tree<T> tree_iterator<T>::remove() {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree<T, Ref, KeyOf, Compare, Augment> tree_iterator<T, Ref, KeyOf, Compare, Augment>::remove() {
     if (auto* owner = this->_owner) {
-      if (_node) {
-        auto* data = this->_owner->_data;
-        auto* other = _node->predecessor(data);
-        if (!other) {
-          other = _node->successor(data);
-        }
-
-        _node->remove(data);
-
-        if (other) {
-          owner->_root = other->root(data);
-        } else {
-          owner->_root = nullptr;
-        }
-        owner->disown_all();
-
-        return tree<T, Ref>{_node, data};
+      if (_node != _before && _node != _after) {
+        auto* removed = _node;
+        owner->remove(*removed);
+        return tree<T, Ref, KeyOf, Compare, Augment>{removed};
       }
     }
-    return tree<T, Ref>{};
+    return tree<T, Ref, KeyOf, Compare, Augment>{};
   }
 
 } // namespace hatch
@@ -6,17 +6,37 @@
 #endif
 
 #include <hatch/utility/container.hh>
+#include <hatch/utility/meta.hh>
 
 #include <cstdint> // uint8_t, uint64_t
 #include <optional> // std::optional
+#include <type_traits> // std::conditional_t, std::is_empty_v
+#include <utility> // std::pair
 
 namespace hatch {
 
-  template <class T, template <class> class Ref>
-  class tree_node : public container<T> {
+  // a node keeps its color in a field of its own, unless its links can carry
+  // it for free.
+  template <bool Packed>
+  class tree_paint {
+  protected:
+    bool _red = false;
+  };
+
+  template <>
+  class tree_paint<true> {
+  };
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  class tree_node : public container<T>, public Augment, protected tree_paint<taggable<Ref<tree_node<T, Ref, KeyOf, Compare, Augment>>>> {
   public:
-    friend class tree<T, Ref>;
-    friend class tree_iterator<T, Ref>;
+    friend class tree<T, Ref, KeyOf, Compare, Augment>;
+    friend class tree_iterator<T, Ref, KeyOf, Compare, Augment>;
+    friend class concurrent_tree<T, KeyOf, Compare, Augment>;
+
+    // nodes that are links of an array are counted in whatever the array holds,
+    // which is the payload when it derives from the node.
+    using element = std::conditional_t<complete<T>, tree_node<T, Ref, KeyOf, Compare, Augment>, T>;
 
   protected:
     enum class colors : bool {
@@ -29,7 +49,7 @@ namespace hatch {
       next,
     };
 
-    sides swap(sides side);
+    static sides swap(sides side);
 
     ///////////////////////////////
     // Constructors, destructor. //
@@ -46,12 +66,41 @@ namespace hatch {
     tree_node(const tree_node&) = delete;
     tree_node& operator=(const tree_node&) = delete;
 
+    ///////////
+    // Keys. //
+    ///////////
+
+  public:
+    // a type can sit in several trees under different orders, in which case it
+    // derives from several nodes and the payload has to be reached from this
+    // one in particular.
+    T& get() const;
+    decltype(auto) key() const;
+
+    template <class L, class R>
+    static bool less(const L& lhs, const R& rhs);
+
+    ///////////////////
+    // Augmentation. //
+    ///////////////////
+
+  public:
+    const Augment& summary() const;
+
+  protected:
+    // trees without a summary to keep skip the walks up to the root entirely.
+    static constexpr bool augmented = !std::is_empty_v<Augment>;
+
+    void refresh();
+    void propagate();
+
     ////////////
     // Color. //
     ////////////
 
   protected:
-    colors _color;
+    // the color rides along in the link to the head when there's room for it.
+    static constexpr bool packed = taggable<Ref<tree_node<T, Ref, KeyOf, Compare, Augment>>>;
 
   public:
     colors color() const;
@@ -68,9 +117,9 @@ namespace hatch {
     ////////////////
 
   protected:
-    Ref<tree_node<T, Ref>> _head;
-    Ref<tree_node<T, Ref>> _prev;
-    Ref<tree_node<T, Ref>> _next;
+    Ref<tree_node<T, Ref, KeyOf, Compare, Augment>> _head;
+    Ref<tree_node<T, Ref, KeyOf, Compare, Augment>> _prev;
+    Ref<tree_node<T, Ref, KeyOf, Compare, Augment>> _next;
 
     ///////////////////////////
     // Structure: accessors. //
@@ -79,20 +128,20 @@ namespace hatch {
   public:
     bool alone() const;
 
-    tree_node<T, Ref>* minimum();
-    const tree_node<T, Ref>* minimum() const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* minimum();
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* minimum() const;
 
-    tree_node<T, Ref>* predecessor();
-    const tree_node<T, Ref>* predecessor() const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* predecessor();
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* predecessor() const;
 
-    tree_node<T, Ref>* root();
-    const tree_node<T, Ref>* root() const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* root();
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* root() const;
 
-    tree_node<T, Ref>* successor();
-    const tree_node<T, Ref>* successor() const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* successor();
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* successor() const;
 
-    tree_node<T, Ref>* maximum();
-    const tree_node<T, Ref>* maximum() const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* maximum();
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* maximum() const;
 
   protected:
     std::optional<sides> side() const;
@@ -100,35 +149,58 @@ namespace hatch {
     bool is_prev() const;
     bool is_next() const;
 
-    tree_node<T, Ref>* head();
-    const tree_node<T, Ref>* head() const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* head();
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* head() const;
 
-    tree_node<T, Ref>* child(sides side);
-    const tree_node<T, Ref>* child(sides side) const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* child(sides side);
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* child(sides side) const;
 
-    tree_node<T, Ref>* prev();
-    const tree_node<T, Ref>* prev() const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* prev();
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* prev() const;
 
-    tree_node<T, Ref>* next();
-    const tree_node<T, Ref>* next() const;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* next();
+    const tree_node<T, Ref, KeyOf, Compare, Augment>* next() const;
 
     //////////////////////////
     // Structure: mutators. //
     //////////////////////////
 
   protected:
-    void make_head(tree_node<T, Ref>* new_head, std::optional<sides> new_side);
-    void make_child(tree_node<T, Ref>* new_child, sides side);
-    void make_next(tree_node<T, Ref>* new_next);
-    void make_prev(tree_node<T, Ref>* new_prev);
+    void make_head(tree_node<T, Ref, KeyOf, Compare, Augment>* new_head, std::optional<sides> new_side);
+    void make_child(tree_node<T, Ref, KeyOf, Compare, Augment>* new_child, sides side);
+    void make_next(tree_node<T, Ref, KeyOf, Compare, Augment>* new_next);
+    void make_prev(tree_node<T, Ref, KeyOf, Compare, Augment>* new_prev);
 
     void detach();
     void rotate(sides side);
-    void exchange(tree_node<T, Ref>* node);
+    void exchange(tree_node<T, Ref, KeyOf, Compare, Augment>* node);
 
   protected:
-    void insert(tree_node& node);
+    void insert(tree_node<T, Ref, KeyOf, Compare, Augment>& node);
     void remove();
+    bool repair();
+
+    //////////////////
+    // Whole trees. //
+    //////////////////
+
+  protected:
+    // a tree by its root, along with the number of black nodes on every path
+    // down from it.
+    class subtree {
+    public:
+      tree_node<T, Ref, KeyOf, Compare, Augment>* _root;
+      uint64_t _height;
+    };
+
+    static uint64_t height(const tree_node<T, Ref, KeyOf, Compare, Augment>* root);
+
+    // everything in lower is ordered before the pivot, which is ordered before
+    // everything in upper.
+    static subtree join(subtree lower, tree_node<T, Ref, KeyOf, Compare, Augment>* pivot, subtree upper);
+
+    template <class K>
+    static std::pair<subtree, subtree> split(subtree whole, const K& key);
   };
 
 } // namespace hatch
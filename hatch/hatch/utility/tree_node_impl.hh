@@ -11,8 +11,8 @@ using std::nullopt;
 
 namespace hatch {
 
-  template <class T, template <class> class Ref>
-  typename tree_node<T, Ref>::sides tree_node<T, Ref>::swap(sides side) {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  typename tree_node<T, Ref, KeyOf, Compare, Augment>::sides tree_node<T, Ref, KeyOf, Compare, Augment>::swap(sides side) {
     switch (side) {
       case sides::prev:
         return sides::next;
@@ -22,47 +22,90 @@ namespace hatch {
     }
   }
 
+  ///////////
+  // Keys. //
+  ///////////
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  T& tree_node<T, Ref, KeyOf, Compare, Augment>::get() const {
+    if constexpr (complete<T>) {
+      return container<T>::get();
+    } else {
+      return const_cast<T&>(static_cast<const T&>(*this));
+    }
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  decltype(auto) tree_node<T, Ref, KeyOf, Compare, Augment>::key() const {
+    return KeyOf{}(get());
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class L, class R>
+  bool tree_node<T, Ref, KeyOf, Compare, Augment>::less(const L& lhs, const R& rhs) {
+    return Compare{}(lhs, rhs);
+  }
+
+  ///////////////////
+  // Augmentation. //
+  ///////////////////
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const Augment& tree_node<T, Ref, KeyOf, Compare, Augment>::summary() const {
+    return *this;
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::refresh() {
+    auto* prev = this->prev();
+    auto* next = this->next();
+    Augment::summarize(get(), prev ? &prev->summary() : nullptr, next ? &next->summary() : nullptr);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::propagate() {
+    if constexpr (augmented) {
+      for (auto* current = this; current; current = current->head()) {
+        current->refresh();
+      }
+    }
+  }
+
   ///////////////////////////////
   // Constructors, destructor. //
   ///////////////////////////////
 
-  template <class T, template <class> class Ref>
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
   template <class ...Args>
-  tree_node<T, Ref>::tree_node(Args&&... args) :
+  tree_node<T, Ref, KeyOf, Compare, Augment>::tree_node(Args&&... args) :
       container<T>::container{std::forward<Args>(args)...},
-      _color{colors::black},
+      Augment{},
       _head{},
       _prev{},
       _next{} {
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>::~tree_node() {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>::~tree_node() {
     detach();
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>::tree_node(tree_node&& moved) noexcept :
-      container<T>::container{std::move(moved)},
-      _color{colors::black},
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>::tree_node(tree_node&& moved) noexcept :
+      container<T>::container{std::move(moved.get())},
+      Augment{},
       _head{},
       _prev{},
       _next{} {
-    auto side = moved.side();
-    make_head(moved._head, side);
-    make_prev(moved._prev);
-    make_next(moved._next);
-  }
-
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>& tree_node<T, Ref>::operator=(tree_node&& moved) noexcept {
-    container<T>::operator=(std::move(moved));
-    _prev = moved._prev;
-    _next = moved._next;
-    _prev->_next = this;
-    _next->_prev = this;
-    moved._prev = &moved;
-    moved._next = &moved;
+    exchange(&moved);
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>& tree_node<T, Ref, KeyOf, Compare, Augment>::operator=(tree_node&& moved) noexcept {
+    container<T>::operator=(std::move(moved.get()));
+    if (this != &moved) {
+      exchange(&moved);
+    }
     return *this;
   }
 
@@ -70,63 +113,71 @@ namespace hatch {
   // Color. //
   ////////////
 
-  template <class T, template <class> class Ref>
-  typename tree_node<T, Ref>::colors tree_node<T, Ref>::color() const {
-    return _color;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  typename tree_node<T, Ref, KeyOf, Compare, Augment>::colors tree_node<T, Ref, KeyOf, Compare, Augment>::color() const {
+    if constexpr (packed) {
+      return _head.tag() ? colors::red : colors::black;
+    } else {
+      return this->_red ? colors::red : colors::black;
+    }
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::make_color(colors color) {
-    _color = color;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::make_color(colors color) {
+    if constexpr (packed) {
+      _head.make_tag(color == colors::red);
+    } else {
+      this->_red = color == colors::red;
+    }
   }
 
-  template <class T, template <class> class Ref>
-  bool tree_node<T, Ref>::is_red() const {
-    return _color == colors::red;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_node<T, Ref, KeyOf, Compare, Augment>::is_red() const {
+    return color() == colors::red;
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::make_red() {
-    _color = colors::red;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::make_red() {
+    make_color(colors::red);
   }
 
-  template <class T, template <class> class Ref>
-  bool tree_node<T, Ref>::is_black() const {
-    return _color == colors::black;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_node<T, Ref, KeyOf, Compare, Augment>::is_black() const {
+    return color() == colors::black;
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::make_black() {
-    _color = colors::black;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::make_black() {
+    make_color(colors::black);
   }
 
   ///////////////////////////
   // Structure: accessors. //
   ///////////////////////////
 
-  template <class T, template <class> class Ref>
-  bool tree_node<T, Ref>::alone() const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_node<T, Ref, KeyOf, Compare, Augment>::alone() const {
     return !_head && !_prev && !_next;
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::minimum() {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::minimum() {
     auto* current = this;
-    while (current->_prev) {
-      current = _prev;
+    while (auto* prev = current->prev()) {
+      current = prev;
     }
     return current;
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::minimum() const {
-    return const_cast<tree_node<T, Ref>&>(*this).minimum();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::minimum() const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).minimum();
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::predecessor() {
-    if (_prev) {
-      return _prev->maximum();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::predecessor() {
+    if (auto* prev = this->prev()) {
+      return prev->maximum();
     } else {
       auto* current = this;
       while (current->is_prev()) {
@@ -136,256 +187,221 @@ namespace hatch {
     }
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::predecessor() const {
-    return const_cast<tree_node<T, Ref>&>(*this).predecessor();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::predecessor() const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).predecessor();
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::root() {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::root() {
     auto* current = this;
-    while (current->_head) {
-      current = _head;
+    while (auto* head = current->head()) {
+      current = head;
     }
     return current;
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::root() const {
-    return const_cast<tree_node<T, Ref>&>(*this).root();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::root() const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).root();
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::successor() {
-    if (_next) {
-      return _next->minimum();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::successor() {
+    if (auto* next = this->next()) {
+      return next->minimum();
     } else {
-      auto current_ref = Ref<tree_node<T, Ref>>{this};
-      auto* current_ptr = this;
-      while (true) {
-        if (auto head_ref = current_ptr->_head) {
-          auto* head_ptr = head_ref.address();
-          if (head_ptr->_next == current_ref) {
-            current_ref = head_ref;
-            current_ptr = head_ptr;
-          } else {
-            break;
-          }
-        }
+      auto* current = this;
+      while (current->is_next()) {
+        current = current->head();
       }
-      return current_ptr->_head;
+      return current->head();
     }
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::successor() const {
-    return const_cast<tree_node<T, Ref>&>(*this).successor();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::successor() const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).successor();
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::maximum() {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::maximum() {
     auto* current = this;
-    while (current->_next) {
-      current = _next;
+    while (auto* next = current->next()) {
+      current = next;
     }
     return current;
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::maximum() const {
-    return const_cast<tree_node<T, Ref>&>(*this).maximum();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::maximum() const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).maximum();
   }
 
-  template <class T, template <class> class Ref>
-  std::optional<typename tree_node<T, Ref>::sides> tree_node<T, Ref>::side() const {
-    if (_head) {
-      auto* head = this->head(data);
-      if (this == head->prev(data)) {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  std::optional<typename tree_node<T, Ref, KeyOf, Compare, Augment>::sides> tree_node<T, Ref, KeyOf, Compare, Augment>::side() const {
+    if (auto* head = this->head()) {
+      if (this == head->prev()) {
         return sides::prev;
       }
-      if (this == head->next(data)) {
+      if (this == head->next()) {
         return sides::next;
       }
     }
-    return {};
+    return nullopt;
   }
 
-  template <class T, template <class> class Ref>
-  bool tree_node<T, Ref>::is_root() const {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_node<T, Ref, KeyOf, Compare, Augment>::is_root() const {
     return !_head;
   }
 
-  template <class T, template <class> class Ref>
-  bool tree_node<T, Ref>::is_prev(void* data) const {
-    if (_head) {
-      auto* head = this->head(data);
-      return this == head->prev(data);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_node<T, Ref, KeyOf, Compare, Augment>::is_prev() const {
+    if (auto* head = this->head()) {
+      return this == head->prev();
     }
     return false;
   }
 
-  template <class T, template <class> class Ref>
-  bool tree_node<T, Ref>::is_next() const {
-    if (_head) {
-      auto* head = this->head(data);
-      return this == head->next(data);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_node<T, Ref, KeyOf, Compare, Augment>::is_next() const {
+    if (auto* head = this->head()) {
+      return this == head->next();
     }
     return false;
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::head(void* data) {
-    if (_head) {
-      return &_head.get(data);
-    }
-    return nullptr;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::head() {
+    return _head ? &*_head : nullptr;
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::head(void* data) const {
-    return const_cast<tree_node<T, Ref>&>(*this)->head(data);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::head() const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).head();
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::child(sides side, void* data) {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::child(sides side) {
     switch (side) {
       case sides::prev:
-        return prev(data);
+        return prev();
       case sides::next:
       default:
-        return next(data);
+        return next();
     }
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::child(sides side, void* data) const {
-    return const_cast<tree_node<T, Ref>&>(*this)->child(side);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::child(sides side) const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).child(side);
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::prev(void* data) {
-    if (_prev) {
-      return &_prev.get(data);
-    }
-    return nullptr;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::prev() {
+    return _prev ? &*_prev : nullptr;
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::prev(void* data) const {
-    return const_cast<tree_node<T, Ref>&>(*this)->prev();
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::prev() const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).prev();
   }
 
-  template <class T, template <class> class Ref>
-  tree_node<T, Ref>* tree_node<T, Ref>::next(void* data) {
-    if (_next) {
-      return &_next.get(data);
-    }
-    return nullptr;
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::next() {
+    return _next ? &*_next : nullptr;
   }
 
-  template <class T, template <class> class Ref>
-  const tree_node<T, Ref>* tree_node<T, Ref>::next(void* data) const {
-    return const_cast<tree_node<T, Ref>&>(*this)->next(data);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  const tree_node<T, Ref, KeyOf, Compare, Augment>* tree_node<T, Ref, KeyOf, Compare, Augment>::next() const {
+    return const_cast<tree_node<T, Ref, KeyOf, Compare, Augment>&>(*this).next();
   }
 
   //////////////////////////
   // Structure: mutators. //
   //////////////////////////
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::make_head(tree_node* new_head, std::optional<sides> new_side, void* data) {
-    if (auto* old_head = head(data)) {
-      if (this == old_head->prev(data)) {
-        old_head->_prev = Ref<T>{nullptr, data};
-      } else if (this == old_head->next(data)) {
-        old_head->_next = Ref<T>{nullptr, data};
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::make_head(tree_node* new_head, std::optional<sides> new_side) {
+    if (auto* old_head = head()) {
+      if (this == old_head->prev()) {
+        old_head->_prev = nullptr;
+      } else if (this == old_head->next()) {
+        old_head->_next = nullptr;
       }
     }
 
-    _head = Ref<T>{new_head, data};
+    _head = new_head;
 
     if (new_head) {
-      auto side = *new_side;
-      if (side == sides::prev) {
-        new_head->_prev = Ref<T>{this, data};
-      } else if (side == sides::next) {
-        new_head->_next = Ref<T>{this, data};
+      switch (*new_side) {
+        case sides::prev:
+          new_head->_prev = this;
+          break;
+        case sides::next:
+          new_head->_next = this;
+          break;
       }
     }
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::make_child(tree_node* new_child, sides side, void* data) {
-    if (auto* old_child = child(side, data)) {
-      old_child->_head = Ref<T>{nullptr, data};
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::make_child(tree_node* new_child, sides side) {
+    if (auto* old_child = child(side)) {
+      old_child->_head = nullptr;
     }
 
     switch (side) {
       case sides::prev:
-        _prev = Ref<T>{new_child, data};
+        _prev = new_child;
         break;
       case sides::next:
-        _next = Ref<T>{new_child, data};
+        _next = new_child;
         break;
     }
 
     if (new_child) {
-      new_child->_head = Ref<T>{this, data};
+      new_child->_head = this;
     }
   }
 
-
-
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::make_prev(tree_node* new_prev, void* data) {
-    if (auto* old_prev = prev(data)) {
-      old_prev->_head = Ref<T>{nullptr, data};
-    }
-
-    _prev = Ref<T>{new_prev, data};
-
-    if (new_prev) {
-      new_prev->_head = Ref<T>{this, data};
-    }
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::make_prev(tree_node* new_prev) {
+    make_child(new_prev, sides::prev);
   }
 
-
-
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::make_next(tree_node* new_next, void* data) {
-    if (auto* old_next = next(data)) {
-      old_next->_head = Ref<T>{nullptr, data};
-    }
-
-    _next = Ref<T>{new_next, data};
-
-    if (new_next) {
-      new_next->_head = Ref<T>{this, data};
-    }
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::make_next(tree_node* new_next) {
+    make_child(new_next, sides::next);
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::detach(void* data) {
-    make_head(nullptr, nullopt, data);
-    make_black(data);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::detach() {
+    make_head(nullptr, nullopt);
+    make_black();
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::rotate(sides direction, void* data) {
-    if (auto* rotated = child(swap(direction), data)) {
-      auto* pivoted = rotated->child(direction, data);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::rotate(sides direction) {
+    if (auto* rotated = child(swap(direction))) {
+      auto* pivoted = rotated->child(direction);
+
+      auto* new_head = head();
+      auto new_side = side();
+      rotated->make_head(new_head, new_side);
 
-      auto* new_head = head(data);
-      auto new_side = side(data);
-      rotated->make_head(new_head, new_side, data);
-      
-      rotated->make_child(this, direction, data);
-      this->make_child(pivoted, swap(direction), data);
+      rotated->make_child(this, direction);
+      this->make_child(pivoted, swap(direction));
+
+      // the rotated node now heads this one, so this one goes first.
+      this->refresh();
+      rotated->refresh();
     }
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::exchange(tree_node<T, Ref>* that, void* data) {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::exchange(tree_node<T, Ref, KeyOf, Compare, Augment>* that) {
     if (that && that != this) {
       auto this_color = this->color();
       auto that_color = that->color();
@@ -393,53 +409,67 @@ namespace hatch {
       this->make_color(that_color);
       that->make_color(this_color);
 
-      static constexpr tree_node* null = nullptr;
-
-      auto [parent, child, joined] =
-          this == that->head(data) ? std::make_tuple(this, that, true) :
-          that == this->head(data) ? std::make_tuple(that, this, true) :
-          std::make_tuple(null, null, false);
+      // each node takes over the summary of the place it moves into. that is
+      // exact when the payloads travel with the places, as when moving, and
+      // otherwise it's up to the caller to refresh the path between them.
+      std::swap(static_cast<Augment&>(*this), static_cast<Augment&>(*that));
+
+      // the links of both nodes are captured up front, because rewiring one of
+      // them will generally disturb the other when they are adjacent or share a
+      // head.
+      auto this_side = this->side();
+      auto* this_head = this->head();
+      auto* this_prev = this->prev();
+      auto* this_next = this->next();
+
+      auto that_side = that->side();
+      auto* that_head = that->head();
+      auto* that_prev = that->prev();
+      auto* that_next = that->next();
+
+      // when one node is the head of the other, the child ends up as the head
+      // of its old head, so its own links have to be redirected at itself.
+      auto relink = [&](tree_node* node, tree_node* from, tree_node* to) {
+        return node == from ? to : node;
+      };
 
-      if (joined) {
-        auto parent_side = parent->side(data);
-        auto child_side = *child->side(data);
+      this->_head = relink(that_head, this, that);
+      this->_prev = relink(that_prev, this, that);
+      this->_next = relink(that_next, this, that);
 
-        auto head = parent->head(data);
-        auto other = parent->child(swap(child_side), data);
-        auto prev = child->prev(data);
-        auto next = child->next(data);
+      that->_head = relink(this_head, that, this);
+      that->_prev = relink(this_prev, that, this);
+      that->_next = relink(this_next, that, this);
 
-        parent->make_head(child, child_side, data);
-        parent->make_prev(prev, data);
-        parent->make_next(next, data);
+      auto adopt = [](tree_node* node, std::optional<sides> side) {
+        if (auto* head = node->head()) {
+          switch (*side) {
+            case sides::prev:
+              head->_prev = node;
+              break;
+            case sides::next:
+              head->_next = node;
+              break;
+          }
+        }
+        if (auto* prev = node->prev()) {
+          prev->_head = node;
+        }
+        if (auto* next = node->next()) {
+          next->_head = node;
+        }
+      };
 
-        child->make_head(head, parent_side, data);
-        child->make_child(other, swap(child_side), data);
-      } else {
-        auto this_side = this->side(data);
-        auto this_head = this->head(data);
-        auto this_prev = this->prev(data);
-        auto this_next = this->next(data);
-
-        auto that_side = that->side(data);
-        auto that_head = that->head(data);
-        auto that_prev = that->prev(data);
-        auto that_next = that->next(data);
-
-        this->make_head(that_head, that_side, data);
-        this->make_prev(that_prev, data);
-        this->make_next(that_next, data);
-
-        that->make_head(this_head, this_side, data);
-        that->make_prev(this_prev, data);
-        that->make_next(this_next, data);
-      }
+      // each node takes over the side the other one hung from, which holds
+      // even when one of them was the head of the other.
+      adopt(this, that_side);
+      adopt(that, this_side);
     }
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::insert(tree_node<T, Ref>& node, void* data) {
-    node.remove(data);
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::insert(tree_node<T, Ref, KeyOf, Compare, Augment>& node) {
+    node.remove();
     node.make_red();
 
     auto* current = &node;
@@ -448,34 +478,45 @@ namespace hatch {
     // here we simply go through the binary search tree insertion procedure. at
     // the end, parent will point to the head of the inserted node.
     while (true) {
-      if (current->get() < parent->get()) {
-        if (auto* prev = parent->prev(data)) {
+      if (less(current->key(), parent->key())) {
+        if (auto* prev = parent->prev()) {
           parent = prev;
           continue;
         } else {
-          parent->make_child(current, sides::prev, data);
+          parent->make_child(current, sides::prev);
           break;
         }
       } else {
-        if (auto* next = parent->next(data)) {
+        if (auto* next = parent->next()) {
           parent = next;
           continue;
         } else {
-          parent->make_child(current, sides::next, data);
+          parent->make_child(current, sides::next);
           break;
         }
       }
     }
 
-    // here we correct the rb properties of the tree.  at the beginning, the
-    // node we just inserted is red.
+    // every summary above the new node now has one more node in it. the
+    // rotations below keep the summaries they touch up to date on their own.
+    current->propagate();
+    current->repair();
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  bool tree_node<T, Ref, KeyOf, Compare, Augment>::repair() {
+    auto* current = this;
+    auto* parent = head();
+
+    // here we correct the rb properties of the tree.  at the beginning, this
+    // node is red and freshly linked in.
     while (parent && parent->is_red()) {
       // node has a red parent, which means it must have a grandparent as well.
-      auto parent_self_side = *parent->side(data);
+      auto parent_self_side = *parent->side();
       auto parent_away_side = swap(parent_self_side);
 
-      auto* grandma = parent->head(data);
-      auto* aunt = grandma->child(parent_away_side, data);
+      auto* grandma = parent->head();
+      auto* aunt = grandma->child(parent_away_side);
 
       if (aunt && aunt->is_red()) {
         // this node's parent has a red sibling.
@@ -488,7 +529,7 @@ namespace hatch {
         aunt->make_black();
 
         current = grandma;
-        parent = current->head(data);
+        parent = current->head();
 
         continue;
       } else {
@@ -497,7 +538,7 @@ namespace hatch {
         // -> rotate the grandparent away putting the parent in its place, then
         //    swap the the colors of the grandparent and the parent.
         //
-        if (current->side(data) == parent_away_side) {
+        if (current->side() == parent_away_side) {
           // this node is on a different side of its parent than its parent is
           // with respect to the parent's parent.
           //
@@ -506,44 +547,46 @@ namespace hatch {
           //    grandparent, then swap the current and parent pointers so the
           //    relationships are correctly labeled.
           //
-          parent->rotate(parent_self_side, data);
+          parent->rotate(parent_self_side);
           std::swap(current, parent);
         }
 
-        grandma->rotate(parent_away_side, data);
+        grandma->rotate(parent_away_side);
         grandma->make_red();
         parent->make_black();
 
-        return;
+        return false;
       }
     }
 
     // we only get here if we break out of the loop, which might happen by
     // recursing up to the root, in which case the root will be red now.
     // if this is the case, make the root black to restore red-black properties.
-    if (current->is_root()) {
+    if (current->is_root() && current->is_red()) {
       // this node is the root.
       //
-      // -> color it black.
+      // -> color it black, which adds a black level to the whole tree.
       //
       current->make_black();
+      return true;
     }
+    return false;
   }
 
-  template <class T, template <class> class Ref>
-  void tree_node<T, Ref>::remove(void* data) {
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  void tree_node<T, Ref, KeyOf, Compare, Augment>::remove() {
     if (!alone()) {
 
-      auto is_null_or_black = [](tree_node<T, Ref>* node) {
+      auto is_null_or_black = [](tree_node<T, Ref, KeyOf, Compare, Augment>* node) {
         return !node || node->is_black();
       };
 
-      auto is_real_and_red = [](tree_node<T, Ref>* node) {
+      auto is_real_and_red = [](tree_node<T, Ref, KeyOf, Compare, Augment>* node) {
         return node && node->is_red();
       };
 
-      auto* prev = this->prev(data);
-      auto* next = this->next(data);
+      auto* prev = this->prev();
+      auto* next = this->next();
 
       if (prev && next) {
         // this node has both children, so we swap it with either the
@@ -553,11 +596,15 @@ namespace hatch {
         // conditions will be restored when we finally remove this node at the
         // end.
         //
-        if (auto* pred = predecessor(data)) {
-          exchange(pred, data);
-        } else if (auto* succ = successor(data)) {
-          exchange(succ, data);
+        if (auto* pred = predecessor()) {
+          exchange(pred);
+        } else if (auto* succ = successor()) {
+          exchange(succ);
         }
+
+        // the payloads between the two places have changed places, so the
+        // summaries along the way have to be brought up to date.
+        propagate();
       }
 
       if (is_black()) {
@@ -566,7 +613,7 @@ namespace hatch {
         // -> if red, no action needed, just fall through to disconnecting this
         //    node from its parent.
         //
-        if (auto* child = prev ? prev : next ? next : nullptr) {
+        if (auto* child = this->prev() ? this->prev() : this->next()) {
           // this node is black and has a child, which must be red, because this
           // node was chosen by construction to have only one child and the black
           // heights on both sides of it must be equal.
@@ -584,13 +631,13 @@ namespace hatch {
           //
           auto* target = this;
           while (target->_head) {
-            auto target_self_side = *target->side(data);
+            auto target_self_side = *target->side();
             auto target_away_side = swap(target_self_side);
 
-            auto* parent = target->head(data);
-            auto* sibling = parent->child(target_away_side, data);
-            auto* inside = sibling->child(target_self_side, data);
-            auto* outside = sibling->child(target_away_side, data);
+            auto* parent = target->head();
+            auto* sibling = parent->child(target_away_side);
+            auto* inside = sibling->child(target_self_side);
+            auto* outside = sibling->child(target_away_side);
 
             // sibling may be red or black.
             if (is_real_and_red(sibling)) {
@@ -605,11 +652,11 @@ namespace hatch {
               parent->make_red();
               sibling->make_black();
 
-              parent->rotate(target_self_side, data);
+              parent->rotate(target_self_side);
 
-              sibling = parent->child(target_away_side, data);
-              inside = sibling->child(target_self_side, data);
-              outside = sibling->child(target_away_side, data);
+              sibling = parent->child(target_away_side);
+              inside = sibling->child(target_self_side);
+              outside = sibling->child(target_away_side);
             }
 
             // sibling must be black now.
@@ -650,10 +697,10 @@ namespace hatch {
                 sibling->make_red();
                 inside->make_black();
 
-                sibling->rotate(target_away_side, data);
+                sibling->rotate(target_away_side);
 
-                sibling = parent->child(target_away_side, data);
-                outside = sibling->child(target_away_side, data);
+                sibling = parent->child(target_away_side);
+                outside = sibling->child(target_away_side);
               }
               // sibling must have a red outside child now, the inside child color
               // is arbitrary.
@@ -665,17 +712,116 @@ namespace hatch {
               parent->make_black();
               outside->make_black();
 
-              parent->rotate(target_self_side, data);
+              parent->rotate(target_self_side);
 
               break;
             }
           }
         }
       }
-      detach(data);
+
+      auto* head = this->head();
+      detach();
+      refresh();
+      if (head) {
+        head->propagate();
+      }
+    }
+  }
+
+  //////////////////
+  // Whole trees. //
+  //////////////////
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  uint64_t tree_node<T, Ref, KeyOf, Compare, Augment>::height(const tree_node<T, Ref, KeyOf, Compare, Augment>* root) {
+    // every path down has the same number of black nodes, so any one will do.
+    auto height = 0lu;
+    for (auto* current = root; current; current = current->prev()) {
+      height += current->is_black() ? 1 : 0;
+    }
+    return height;
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  typename tree_node<T, Ref, KeyOf, Compare, Augment>::subtree tree_node<T, Ref, KeyOf, Compare, Augment>::join(subtree lower, tree_node<T, Ref, KeyOf, Compare, Augment>* pivot, subtree upper) {
+    if (lower._height == upper._height) {
+      // the trees are equally tall.
+      //
+      // -> hang both of them from the pivot, which becomes a black root.
+      //
+      pivot->make_child(lower._root, sides::prev);
+      pivot->make_child(upper._root, sides::next);
+      pivot->make_black();
+      pivot->refresh();
+      return {pivot, lower._height + 1};
+    }
+
+    // one tree is taller than the other.
+    //
+    // -> go down the inner edge of the taller tree to the first black node of
+    //    the same black height as the shorter tree, put the pivot in its place
+    //    as a red node heading both of them, and repair the tree from there as
+    //    if the pivot had just been inserted.
+    //
+    auto taller = lower._height > upper._height ? lower : upper;
+    auto shorter = lower._height > upper._height ? upper : lower;
+    auto inward = lower._height > upper._height ? sides::next : sides::prev;
+
+    auto height = taller._height;
+    tree_node<T, Ref, KeyOf, Compare, Augment>* head = nullptr;
+    auto* current = taller._root;
+    while (height > shorter._height || (current && current->is_red())) {
+      height -= current->is_black() ? 1 : 0;
+      head = current;
+      current = current->child(inward);
+    }
+
+    head->make_child(pivot, inward);
+    pivot->make_child(current, swap(inward));
+    pivot->make_child(shorter._root, inward);
+    pivot->make_red();
+
+    pivot->propagate();
+    auto grew = pivot->repair();
+    return {taller._root->root(), taller._height + (grew ? 1 : 0)};
+  }
+
+  template <class T, template <class> class Ref, class KeyOf, class Compare, class Augment>
+  template <class K>
+  std::pair<typename tree_node<T, Ref, KeyOf, Compare, Augment>::subtree, typename tree_node<T, Ref, KeyOf, Compare, Augment>::subtree> tree_node<T, Ref, KeyOf, Compare, Augment>::split(subtree whole, const K& key) {
+    auto* root = whole._root;
+    if (!root) {
+      return {subtree{nullptr, 0}, subtree{nullptr, 0}};
+    }
+
+    // the children become trees of their own, and a red one turns black to be
+    // a proper root, which makes it one black level taller.
+    auto height = whole._height - (root->is_black() ? 1 : 0);
+    auto cut = [root, height](sides side) {
+      auto* child = root->child(side);
+      root->make_child(nullptr, side);
+      if (child && child->is_red()) {
+        child->make_black();
+        return subtree{child, height + 1};
+      }
+      return subtree{child, height};
+    };
+
+    auto prev = cut(sides::prev);
+    auto next = cut(sides::next);
+
+    // the root goes to whichever side its key falls on, and serves as the
+    // pivot that joins that side back together.
+    if (less(root->key(), key)) {
+      auto [lower, upper] = split(next, key);
+      return {join(prev, root, lower), upper};
+    } else {
+      auto [lower, upper] = split(prev, key);
+      return {lower, join(upper, root, next)};
     }
   }
 
 } // namespace hatch
 
-#endif // HATCH_TREE_NODE_IMPL_HH
\ No newline at end of file
+#endif // HATCH_TREE_NODE_IMPL_HH
@@ -0,0 +1,182 @@
+#include <hatch/core/btree.hh>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace hatch {
+
+  class BTreeTest : public ::testing::Test {
+  public:
+    class record {
+    public:
+      record(uint64_t key, std::string name) :
+          key{key}, name{std::move(name)} {
+      }
+
+      uint64_t key;
+      std::string name;
+    };
+
+    class key_of {
+    public:
+      uint64_t operator()(const record& value) const {
+        return value.key;
+      }
+    };
+
+  protected:
+    static constexpr unsigned int count = 2048;
+
+    std::unique_ptr<allocator> _allocator;
+    std::vector<uint64_t> _order;
+
+    void SetUp() override {
+      _allocator = std::make_unique<allocator>();
+      for (auto index = 0u; index < count; index++) {
+        _order.push_back(index);
+      }
+      std::mt19937 engine{97531};
+      std::shuffle(_order.begin(), _order.end(), engine);
+    }
+  };
+
+  TEST_F(BTreeTest, EmptyTest) {
+    btree<uint64_t> tree{*_allocator};
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.size(), 0);
+    EXPECT_EQ(tree.begin(), tree.end());
+    EXPECT_EQ(tree.find(3), tree.end());
+    EXPECT_FALSE(tree.remove(3));
+  }
+
+  TEST_F(BTreeTest, InsertTest) {
+    btree<uint64_t> tree{*_allocator};
+    for (auto value : _order) {
+      EXPECT_EQ(*tree.insert(value), value);
+    }
+    EXPECT_EQ(tree.size(), count);
+
+    // forwards along the leaf chain, and backwards from the end.
+    auto expected = 0lu;
+    for (auto value : tree) {
+      EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, count);
+
+    auto iterator = tree.end();
+    while (iterator != tree.begin()) {
+      --iterator;
+      EXPECT_EQ(*iterator, --expected);
+    }
+    EXPECT_EQ(expected, 0);
+
+    for (auto value = 0lu; value < count; value++) {
+      EXPECT_EQ(*tree.find(value), value);
+    }
+    EXPECT_EQ(tree.find(count), tree.end());
+
+    // the nodes come out of the allocator, many payloads to a node.
+    auto nodes = 0lu;
+    for (auto& statistic : _allocator->statistics()) {
+      nodes += statistic._used;
+    }
+    EXPECT_GT(nodes, count / 16);
+    EXPECT_LT(nodes, count / 4);
+
+    // and they stay put, since they point straight at each other.
+    EXPECT_EQ(_allocator->compact(), 0);
+    EXPECT_EQ(*tree.find(count / 2), count / 2);
+  }
+
+  TEST_F(BTreeTest, BoundsTest) {
+    btree<uint64_t> tree{*_allocator};
+    for (auto value : _order) {
+      tree.insert(value * 2);
+    }
+
+    EXPECT_EQ(*tree.lower_bound(33), 34);
+    EXPECT_EQ(*tree.upper_bound(33), 34);
+    EXPECT_EQ(*tree.lower_bound(34), 34);
+    EXPECT_EQ(*tree.upper_bound(34), 36);
+    EXPECT_EQ(*tree.lower_bound(0), 0);
+    EXPECT_EQ(tree.lower_bound(count * 2), tree.end());
+    EXPECT_EQ(tree.upper_bound(count * 2 - 2), tree.end());
+    EXPECT_EQ(tree.find(33), tree.end());
+  }
+
+  TEST_F(BTreeTest, DuplicateTest) {
+    // small nodes, so that runs of equal keys span several of them.
+    btree<record, key_of, std::less<>, 4> tree{*_allocator};
+    for (auto value : _order) {
+      tree.insert(record{value % 16, std::to_string(value)});
+    }
+
+    for (auto key = 0lu; key < 16; key++) {
+      auto first = tree.lower_bound(key);
+      auto last = tree.upper_bound(key);
+      auto found = 0lu;
+      for (auto iterator = first; iterator != last; ++iterator) {
+        EXPECT_EQ(iterator->key, key);
+        found++;
+      }
+      EXPECT_EQ(found, count / 16);
+      EXPECT_EQ(tree.find(key), first);
+    }
+  }
+
+  TEST_F(BTreeTest, RemoveTest) {
+    btree<record, key_of, std::less<>, 4> tree{*_allocator};
+    for (auto value : _order) {
+      tree.insert(record{value, std::to_string(value)});
+    }
+
+    std::set<uint64_t> remaining{_order.begin(), _order.end()};
+    std::mt19937 engine{86420};
+    std::shuffle(_order.begin(), _order.end(), engine);
+    for (auto value : _order) {
+      EXPECT_TRUE(tree.remove(value));
+      EXPECT_FALSE(tree.remove(value));
+      remaining.erase(value);
+      EXPECT_EQ(tree.size(), remaining.size());
+
+      // the whole tree is only walked now and then, to keep this quick.
+      if (remaining.size() % 97 == 0) {
+        auto expected = remaining.begin();
+        for (auto& entry : tree) {
+          EXPECT_EQ(entry.key, *expected);
+          EXPECT_EQ(entry.name, std::to_string(*expected));
+          ++expected;
+        }
+        EXPECT_EQ(expected, remaining.end());
+      }
+    }
+
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.begin(), tree.end());
+
+    // everything went back to the allocator.
+    for (auto& statistic : _allocator->statistics()) {
+      EXPECT_EQ(statistic._used, 0);
+    }
+  }
+
+  TEST_F(BTreeTest, ClearTest) {
+    btree<record, key_of> tree{*_allocator};
+    for (auto value : _order) {
+      tree.insert(record{value, std::string(64, 'x')});
+    }
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+    for (auto& statistic : _allocator->statistics()) {
+      EXPECT_EQ(statistic._used, 0);
+    }
+  }
+
+} // namespace hatch
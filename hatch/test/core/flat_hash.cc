@@ -0,0 +1,191 @@
+#include <hatch/core/flat_hash.hh>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <cstdint>
+
+namespace hatch {
+
+  class FlatHashTest : public ::testing::Test {
+  public:
+    class record {
+    public:
+      record(uint64_t key, std::string name) :
+          key{key}, name{std::move(name)} {
+      }
+
+      uint64_t key;
+      std::string name;
+    };
+
+    class key_of {
+    public:
+      uint64_t operator()(const record& value) const {
+        return value.key;
+      }
+    };
+
+  protected:
+    static constexpr unsigned int count = 4096;
+
+    std::unique_ptr<allocator> _allocator;
+
+    void SetUp() override {
+      _allocator = std::make_unique<allocator>();
+    }
+  };
+
+  TEST_F(FlatHashTest, EmptyTest) {
+    flat_hash<uint64_t> table{*_allocator};
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.size(), 0u);
+    EXPECT_EQ(table.capacity(), 0u);
+    EXPECT_EQ(table.find(3lu), nullptr);
+    EXPECT_FALSE(table.remove(3lu));
+  }
+
+  TEST_F(FlatHashTest, InsertTest) {
+    flat_hash<uint64_t> table{*_allocator};
+    for (auto value = 0lu; value < count; value++) {
+      auto [inserted, fresh] = table.insert(value * 3);
+      EXPECT_TRUE(fresh);
+      EXPECT_EQ(*inserted, value * 3);
+    }
+    EXPECT_EQ(table.size(), count);
+    EXPECT_LE(table.size() * 8, table.capacity() * 7);
+
+    // a second insertion of a key finds the first one.
+    auto [existing, fresh] = table.insert(9);
+    EXPECT_FALSE(fresh);
+    EXPECT_EQ(*existing, 9u);
+    EXPECT_EQ(table.size(), count);
+
+    for (auto value = 0lu; value < count * 3; value++) {
+      auto* found = table.find(value);
+      if (value % 3 == 0) {
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, value);
+      } else {
+        EXPECT_EQ(found, nullptr);
+      }
+    }
+
+    auto visited = 0lu;
+    table.visit([&](uint64_t value) { visited += value % 3 == 0 ? 1 : 0; });
+    EXPECT_EQ(visited, count);
+  }
+
+  TEST_F(FlatHashTest, FitTest) {
+    // a group takes as many slots as fill its slab class, so neither of these
+    // is left with a slab that's nearly half empty.
+    using numbers = flat_hash_group<uint64_t>;
+    using records = flat_hash_group<record, key_of>;
+    EXPECT_LT(numbers::width, numbers::lanes);
+    EXPECT_LE((waste<slablist, numbers, records>::percent), 5u);
+
+    flat_hash<uint64_t> table{*_allocator};
+    table.insert(1);
+    EXPECT_EQ(table.capacity(), numbers::width);
+    for (auto value = 2lu; value < count; value++) {
+      table.insert(value);
+    }
+    for (auto value = 1lu; value < count; value++) {
+      ASSERT_NE(table.find(value), nullptr);
+    }
+  }
+
+  TEST_F(FlatHashTest, ChurnTest) {
+    flat_hash<record, key_of> table{*_allocator};
+    std::unordered_map<uint64_t, std::string> expected;
+
+    // a small key range with plenty of removals leaves deleted slots all over,
+    // which the table has to keep probing past and eventually clear out.
+    std::mt19937 engine{24680};
+    std::uniform_int_distribution<uint64_t> keys{0, 511};
+    for (auto round = 0u; round < count * 8; round++) {
+      auto key = keys(engine);
+      if (engine() % 2) {
+        auto name = std::to_string(round);
+        auto [inserted, fresh] = table.insert(record{key, name});
+        EXPECT_EQ(fresh, expected.emplace(key, name).second);
+        EXPECT_EQ(inserted->name, expected[key]);
+      } else {
+        EXPECT_EQ(table.remove(key), expected.erase(key) == 1);
+      }
+    }
+    EXPECT_EQ(table.size(), expected.size());
+    EXPECT_LE(table.capacity(), 2048u);
+
+    for (auto key = 0lu; key < 512; key++) {
+      auto* found = table.find(key);
+      if (expected.count(key)) {
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found->name, expected[key]);
+      } else {
+        EXPECT_EQ(found, nullptr);
+      }
+    }
+  }
+
+  TEST_F(FlatHashTest, MoveOnlyTest) {
+    class key_of_owned {
+    public:
+      uint64_t operator()(const std::unique_ptr<uint64_t>& value) const {
+        return *value;
+      }
+    };
+
+    flat_hash<std::unique_ptr<uint64_t>, key_of_owned> table{*_allocator};
+    for (auto value = 0lu; value < count; value++) {
+      EXPECT_TRUE(table.insert(std::make_unique<uint64_t>(value)).second);
+    }
+    for (auto value = 0lu; value < count; value += 2) {
+      EXPECT_TRUE(table.remove(value));
+    }
+    EXPECT_EQ(table.size(), count / 2);
+
+    auto* found = table.find(7lu);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(**found, 7u);
+    EXPECT_EQ(table.find(8lu), nullptr);
+  }
+
+  TEST_F(FlatHashTest, MoveTest) {
+    flat_hash<uint64_t> table{*_allocator};
+    for (auto value = 0lu; value < count; value++) {
+      table.insert(value);
+    }
+
+    flat_hash<uint64_t> moved{std::move(table)};
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.find(7lu), nullptr);
+    EXPECT_EQ(moved.size(), count);
+    EXPECT_NE(moved.find(7lu), nullptr);
+
+    table = std::move(moved);
+    EXPECT_EQ(table.size(), count);
+    EXPECT_NE(table.find(14lu), nullptr);
+
+    // the moved-from table is still usable.
+    moved.insert(3);
+    EXPECT_EQ(moved.size(), 1u);
+  }
+
+  TEST_F(FlatHashTest, ClearTest) {
+    flat_hash<record, key_of> table{*_allocator};
+    for (auto key = 0lu; key < count; key++) {
+      table.insert(record{key, std::to_string(key)});
+    }
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.find(7lu), nullptr);
+
+    table.insert(record{7, "seven"});
+    EXPECT_EQ(table.find(7lu)->name, "seven");
+  }
+
+}
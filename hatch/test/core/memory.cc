@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <iostream>
 #include <memory>
+#include <new>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include <cmath>
 
@@ -17,294 +21,850 @@ namespace hatch {
       double _num;
     };
 
-    //std::unique_ptr<allocator<numeric>> _allocator;
+    class counted {
+    public:
+      counted(int value) :
+          _value{value} {
+        ++alive;
+      }
+
+      ~counted() {
+        --alive;
+      }
+
+      int _value;
+      static std::atomic<int> alive;
+    };
+
+    std::unique_ptr<allocator> _allocator;
 
   protected:
-//    void SetUp() override {
-//      _allocator = std::make_unique<allocator<numeric>>(16, 4);
-//    }
+    void SetUp() override {
+      _allocator = std::make_unique<allocator>();
+      counted::alive = 0;
+    }
   };
 
+  std::atomic<int> MemoryTest::counted::alive = 0;
+
   TEST_F(MemoryTest, DummyTest) {
     numeric one{1, 3, 0.2};
     numeric two{2, 4, 0.5};
     EXPECT_EQ((one._a + two._b)*(one._b + two._a), 10 * two._num / one._num);
   }
 
-//  TEST_F(MemoryTest, SimpleCreateTest) {
-//    auto ptr = _allocator->create(5, 7, 9.11);
-//    EXPECT_EQ(ptr.null(), false);
-//    EXPECT_EQ(_allocator->allocated(), 1);
-//
-//    EXPECT_EQ(ptr->_a, 5);
-//    EXPECT_EQ(ptr->_b, 7);
-//    EXPECT_EQ(ptr->_num, 9.11);
-//
-//    _allocator->destroy(ptr);
-//    EXPECT_EQ(ptr.null(), true);
-//    EXPECT_EQ(_allocator->allocated(), 0);
-//  }
-//
-//  TEST_F(MemoryTest, SimpleCopyTest) {
-//    auto ptr = _allocator->create(5, 7, 9.11);
-//    auto cpy = ptr;
-//    EXPECT_EQ(ptr.null(), false);
-//    EXPECT_EQ(cpy.null(), false);
-//    EXPECT_EQ(_allocator->allocated(), 1);
-//
-//    EXPECT_EQ(cpy->_a, 5);
-//    EXPECT_EQ(cpy->_b, 7);
-//    EXPECT_EQ(cpy->_num, 9.11);
-//
-//    _allocator->destroy(cpy);
-//    EXPECT_EQ(ptr.null(), true);
-//    EXPECT_EQ(cpy.null(), true);
-//    EXPECT_EQ(_allocator->allocated(), 0);
-//  }
-//
-//  TEST_F(MemoryTest, SimpleMoveTest) {
-//    auto ptr = _allocator->create(5, 7, 9.11);
-//    auto mvd = std::move(ptr);
-//    EXPECT_EQ(ptr.null(), true);
-//    EXPECT_EQ(mvd.null(), false);
-//    EXPECT_EQ(_allocator->allocated(), 1);
-//
-//    EXPECT_EQ(mvd->_a, 5);
-//    EXPECT_EQ(mvd->_b, 7);
-//    EXPECT_EQ(mvd->_num, 9.11);
-//
-//    _allocator->destroy(mvd);
-//    EXPECT_EQ(ptr.null(), true);
-//    EXPECT_EQ(mvd.null(), true);
-//    EXPECT_EQ(_allocator->allocated(), 0);
-//  }
-//
-//  TEST_F(MemoryTest, SimpleScopeTest) {
-//    {
-//      auto ptr = _allocator->create(5, 7, 9.11);
-//      auto cpy = ptr;
-//      auto mvd = std::move(ptr);
-//      EXPECT_EQ(ptr.null(), true);
-//      EXPECT_EQ(cpy.null(), false);
-//      EXPECT_EQ(mvd.null(), false);
-//      EXPECT_EQ(_allocator->allocated(), 1);
-//
-//      EXPECT_EQ(cpy->_a, 5);
-//      EXPECT_EQ(cpy->_b, 7);
-//      EXPECT_EQ(cpy->_num, 9.11);
-//
-//      EXPECT_EQ(mvd->_a, 5);
-//      EXPECT_EQ(mvd->_b, 7);
-//      EXPECT_EQ(mvd->_num, 9.11);
-//    }
-//    EXPECT_EQ(_allocator->allocated(), 0);
-//  }
-//
-//  TEST_F(MemoryTest, ComplexGrowShrinkTest) {
-//    std::vector<pointer<numeric>> ptrs;
-//    ptrs.reserve(1024);
-//
-//    EXPECT_EQ(_allocator->allocated(), 0);
-//    EXPECT_EQ(_allocator->capacity(), 16);
-//    EXPECT_EQ(_allocator->growth_increment(), 16);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//
-//    auto adder = [&](int index) {
-//      static auto num = std::atan(1.);
-//      ptrs.push_back(std::move(_allocator->create(2 * index, 2 * index + 1, index * num)));
-//    };
-//
-//
-//    for (auto index = 0; index < 15; index++) {
-//      adder(index);
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 16);
-//      EXPECT_EQ(_allocator->growth_increment(), 16);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//    }
-//
-//    adder(15);
-//    EXPECT_EQ(_allocator->allocated(), 16);
-//    EXPECT_EQ(_allocator->capacity(), 32);
-//    EXPECT_EQ(_allocator->growth_increment(), 32);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//
-//
-//    for (auto index = 16; index < 31; index++) {
-//      adder(index);
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 32);
-//      EXPECT_EQ(_allocator->growth_increment(), 32);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//    }
-//
-//    adder(31);
-//    EXPECT_EQ(_allocator->allocated(), 32);
-//    EXPECT_EQ(_allocator->capacity(), 64);
-//    EXPECT_EQ(_allocator->growth_increment(), 64);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//
-//
-//    for (auto index = 32; index < 63; index++) {
-//      adder(index);
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 64);
-//      EXPECT_EQ(_allocator->growth_increment(), 64);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//    }
-//
-//    adder(63);
-//    EXPECT_EQ(_allocator->allocated(), 64);
-//    EXPECT_EQ(_allocator->capacity(), 128);
-//    EXPECT_EQ(_allocator->growth_increment(), 128);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 32);
-//
-//
-//    for (auto index = 64; index < 127; index++) {
-//      adder(index);
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 128);
-//      EXPECT_EQ(_allocator->growth_increment(), 128);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 32);
-//    }
-//
-//    adder(127);
-//    EXPECT_EQ(_allocator->allocated(), 128);
-//    EXPECT_EQ(_allocator->capacity(), 256);
-//    EXPECT_EQ(_allocator->growth_increment(), 256);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 64);
-//
-//
-//    for (auto index = 128; index < 255; index++) {
-//      adder(index);
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 256);
-//      EXPECT_EQ(_allocator->growth_increment(), 256);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 64);
-//    }
-//
-//    adder(255);
-//    EXPECT_EQ(_allocator->allocated(), 256);
-//    EXPECT_EQ(_allocator->capacity(), 512);
-//    EXPECT_EQ(_allocator->growth_increment(), 256);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 128);
-//
-//    for (auto index = 256; index < 511; index++) {
-//      adder(index);
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 512);
-//      EXPECT_EQ(_allocator->growth_increment(), 256);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 128);
-//    }
-//
-//    adder(511);
-//    EXPECT_EQ(_allocator->allocated(), 512);
-//    EXPECT_EQ(_allocator->capacity(), 768);
-//    EXPECT_EQ(_allocator->growth_increment(), 256);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 256);
-//
-//    for (auto index = 512; index < 767; index++) {
-//      adder(index);
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 768);
-//      EXPECT_EQ(_allocator->growth_increment(), 256);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 256);
-//    }
-//
-//    adder(767);
-//    EXPECT_EQ(_allocator->allocated(), 768);
-//    EXPECT_EQ(_allocator->capacity(), 1024);
-//    EXPECT_EQ(_allocator->growth_increment(), 256);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 256);
-//
-//    for (auto index = 768; index < 1023; index++) {
-//      adder(index);
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 1024);
-//      EXPECT_EQ(_allocator->growth_increment(), 256);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 256);
-//    }
-//
-//    std::random_shuffle(ptrs.begin(), ptrs.end());
-//
-//    for (auto index = 1022; index >= 256; index--) {
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 1024);
-//      EXPECT_EQ(_allocator->growth_increment(), 256);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 256);
-//      ptrs.pop_back();
-//    }
-//
-//    EXPECT_EQ(_allocator->allocated(), 256);
-//    EXPECT_EQ(_allocator->capacity(), 512);
-//    EXPECT_EQ(_allocator->growth_increment(), 256);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 128);
-//    ptrs.pop_back();
-//
-//    for (auto index = 254; index >= 128; index--) {
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 512);
-//      EXPECT_EQ(_allocator->growth_increment(), 256);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 128);
-//      ptrs.pop_back();
-//    }
-//
-//    EXPECT_EQ(_allocator->allocated(), 128);
-//    EXPECT_EQ(_allocator->capacity(), 256);
-//    EXPECT_EQ(_allocator->growth_increment(), 256);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 64);
-//    ptrs.pop_back();
-//
-//    for (auto index = 126; index >= 64; index--) {
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 256);
-//      EXPECT_EQ(_allocator->growth_increment(), 256);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 64);
-//      ptrs.pop_back();
-//    }
-//
-//    EXPECT_EQ(_allocator->allocated(), 64);
-//    EXPECT_EQ(_allocator->capacity(), 128);
-//    EXPECT_EQ(_allocator->growth_increment(), 128);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 32);
-//    ptrs.pop_back();
-//
-//    for (auto index = 62; index >= 32; index--) {
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 128);
-//      EXPECT_EQ(_allocator->growth_increment(), 128);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 32);
-//      ptrs.pop_back();
-//    }
-//
-//    EXPECT_EQ(_allocator->allocated(), 32);
-//    EXPECT_EQ(_allocator->capacity(), 64);
-//    EXPECT_EQ(_allocator->growth_increment(), 64);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//    ptrs.pop_back();
-//
-//    for (auto index = 30; index >= 16; index--) {
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 64);
-//      EXPECT_EQ(_allocator->growth_increment(), 64);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//      ptrs.pop_back();
-//    }
-//
-//    EXPECT_EQ(_allocator->allocated(), 16);
-//    EXPECT_EQ(_allocator->capacity(), 32);
-//    EXPECT_EQ(_allocator->growth_increment(), 32);
-//    EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//    ptrs.pop_back();
-//
-//    for (auto index = 14; index >= 0; index--) {
-//      EXPECT_EQ(_allocator->allocated(), index + 1);
-//      EXPECT_EQ(_allocator->capacity(), 32);
-//      EXPECT_EQ(_allocator->growth_increment(), 32);
-//      EXPECT_EQ(_allocator->shrink_threshold(), 16);
-//      ptrs.pop_back();
-//    }
-//
-//    EXPECT_EQ(_allocator->allocated(), 0);
-//  }
-}
\ No newline at end of file
+  TEST_F(MemoryTest, SlabsTest) {
+    static_assert(std::is_same_v<doubling<8, 8192>, slabs<8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192>>);
+    static_assert(slab<numeric> == sizeof(numeric));
+
+    using tight = geometric<8, 8192, 5, 4>;
+    static_assert(tight::slab<char[65]> == 72);
+    static_assert(tight::slab<char[8192]> == 8192);
+    static_assert(tight::slab<char[8000]> == 8192);
+
+    using report = waste<doubling<8, 8192>, char[65], char[128], numeric>;
+    EXPECT_EQ(report::classes[0], 128);
+    EXPECT_EQ(report::bytes[0], 63);
+    EXPECT_EQ(report::bytes[1], 0);
+    EXPECT_EQ(report::total, 63);
+    EXPECT_EQ(report::worst, 63);
+    EXPECT_EQ(report::percent, 49);
+
+    using tighter = waste<tight, char[65], char[128], numeric>;
+    EXPECT_LT(tighter::worst, report::worst);
+    EXPECT_LE(tighter::percent, 20);
+  }
+
+  TEST_F(MemoryTest, SimpleCreateTest) {
+    auto ptr = _allocator->create<numeric>(5, 7, 9.11);
+    EXPECT_TRUE(ptr);
+
+    EXPECT_EQ(ptr->_a, 5);
+    EXPECT_EQ(ptr->_b, 7);
+    EXPECT_EQ(ptr->_num, 9.11);
+
+    _allocator->destroy(ptr);
+    EXPECT_FALSE(ptr);
+  }
+
+  TEST_F(MemoryTest, SimpleCopyTest) {
+    auto ptr = _allocator->create<counted>(3);
+    auto cpy = ptr;
+    EXPECT_TRUE(ptr);
+    EXPECT_TRUE(cpy);
+    EXPECT_EQ(&*ptr, &*cpy);
+    EXPECT_EQ(counted::alive, 1);
+
+    _allocator->destroy(cpy);
+    EXPECT_FALSE(ptr);
+    EXPECT_FALSE(cpy);
+    EXPECT_EQ(counted::alive, 0);
+  }
+
+  TEST_F(MemoryTest, SimpleMoveTest) {
+    auto ptr = _allocator->create<counted>(5);
+    auto mvd = std::move(ptr);
+    EXPECT_FALSE(ptr);
+    EXPECT_TRUE(mvd);
+    EXPECT_EQ(mvd->_value, 5);
+    EXPECT_EQ(counted::alive, 1);
+
+    _allocator->destroy(mvd);
+    EXPECT_FALSE(mvd);
+    EXPECT_EQ(counted::alive, 0);
+  }
+
+  TEST_F(MemoryTest, SimpleScopeTest) {
+    {
+      auto ptr = _allocator->create<counted>(7);
+      {
+        auto cpy = ptr;
+        auto mvd = std::move(ptr);
+        EXPECT_FALSE(ptr);
+        EXPECT_TRUE(cpy);
+        EXPECT_TRUE(mvd);
+        EXPECT_EQ(cpy->_value, 7);
+        EXPECT_EQ(mvd->_value, 7);
+      }
+      EXPECT_FALSE(ptr);
+      EXPECT_EQ(counted::alive, 0);
+
+      ptr = _allocator->create<counted>(9);
+      auto other = _allocator->create<counted>(11);
+      EXPECT_EQ(counted::alive, 2);
+
+      ptr = other;
+      EXPECT_EQ(counted::alive, 1);
+      EXPECT_EQ(ptr->_value, 11);
+    }
+    EXPECT_EQ(counted::alive, 0);
+  }
+
+  TEST_F(MemoryTest, SlotReuseTest) {
+    auto ptr = _allocator->create<numeric>(1, 2, 3.);
+    auto* address = &*ptr;
+    _allocator->destroy(ptr);
+
+    auto again = _allocator->create<numeric>(4, 5, 6.);
+    EXPECT_EQ(&*again, address);
+    EXPECT_EQ(again->_a, 4);
+  }
+
+  TEST_F(MemoryTest, LowestSlotReuseTest) {
+    auto first = _allocator->create<numeric>(1, 1, 1.);
+    auto second = _allocator->create<numeric>(2, 2, 2.);
+    auto third = _allocator->create<numeric>(3, 3, 3.);
+
+    auto* first_address = &*first;
+    auto* third_address = &*third;
+    EXPECT_LT(first_address, &*second);
+    EXPECT_LT(&*second, third_address);
+
+    _allocator->destroy(third);
+    _allocator->destroy(first);
+
+    auto lower = _allocator->create<numeric>(4, 4, 4.);
+    auto upper = _allocator->create<numeric>(5, 5, 5.);
+    EXPECT_EQ(&*lower, first_address);
+    EXPECT_EQ(&*upper, third_address);
+  }
+
+  TEST_F(MemoryTest, PageRecycleTest) {
+    constexpr auto count = 4096;
+
+    auto pages = [this](std::vector<pointer<numeric>>& ptrs) {
+      std::set<uintptr_t> result;
+      for (auto& ptr : ptrs) {
+        result.insert(reinterpret_cast<uintptr_t>(&*ptr) & ~(_allocator->pagesize() - 1));
+      }
+      return result;
+    };
+
+    std::vector<pointer<numeric>> ptrs;
+    for (auto index = 0; index < count; index++) {
+      ptrs.push_back(_allocator->create<numeric>(index, index, 0.));
+    }
+    auto before = pages(ptrs);
+    EXPECT_GT(before.size(), 2);
+
+    ptrs.clear();
+    for (auto index = 0; index < count; index++) {
+      ptrs.push_back(_allocator->create<numeric>(-index, -index, 1.));
+    }
+    EXPECT_EQ(pages(ptrs), before);
+
+    for (auto index = 0; index < count; index++) {
+      EXPECT_EQ(ptrs[index]->_a, -index);
+      EXPECT_EQ(ptrs[index]->_num, 1.);
+    }
+  }
+
+  TEST_F(MemoryTest, CompactTest) {
+    constexpr auto count = 4096;
+
+    auto pages = [this](std::vector<pointer<numeric>>& ptrs) {
+      std::set<uintptr_t> result;
+      for (auto& ptr : ptrs) {
+        if (ptr) {
+          result.insert(reinterpret_cast<uintptr_t>(&*ptr) & ~(_allocator->pagesize() - 1));
+        }
+      }
+      return result;
+    };
+
+    std::vector<pointer<numeric>> ptrs;
+    for (auto index = 0; index < count; index++) {
+      ptrs.push_back(_allocator->create<numeric>(index, -index, 0.5 * index));
+    }
+    auto before = pages(ptrs).size();
+
+    // keep every sixteenth object, and a second handle to every other one of
+    // those, so that handles have to be re-pointed in bulk.
+    std::vector<pointer<numeric>> copies;
+    for (auto index = 0; index < count; index++) {
+      if (index % 16) {
+        _allocator->destroy(ptrs[index]);
+      } else if (index % 32) {
+        copies.push_back(ptrs[index]);
+      }
+    }
+    EXPECT_EQ(pages(ptrs).size(), before);
+
+    auto reclaimed = _allocator->compact();
+    EXPECT_GT(reclaimed, 0);
+    EXPECT_LT(pages(ptrs).size(), before / 4);
+    EXPECT_EQ(_allocator->compact(), 0);
+
+    for (auto index = 0; index < count; index += 16) {
+      ASSERT_TRUE(ptrs[index]);
+      EXPECT_EQ(ptrs[index]->_a, index);
+      EXPECT_EQ(ptrs[index]->_b, -index);
+      EXPECT_EQ(ptrs[index]->_num, 0.5 * index);
+    }
+    for (auto& copy : copies) {
+      EXPECT_EQ(&*copy, &*ptrs[copy->_a]);
+    }
+  }
+
+  TEST_F(MemoryTest, CompactRemoteTest) {
+    constexpr auto count = 4096;
+
+    auto page = [this](pointer<numeric>& ptr) {
+      return reinterpret_cast<uintptr_t>(&*ptr) & ~(_allocator->pagesize() - 1);
+    };
+
+    std::vector<pointer<numeric>> ptrs;
+    std::set<uintptr_t> pages;
+    for (auto index = 0; index < count; index++) {
+      ptrs.push_back(_allocator->create<numeric>(index, -index, 0.5 * index));
+      pages.insert(page(ptrs.back()));
+    }
+    ASSERT_GT(pages.size(), 3);
+    auto spare = *pages.begin();
+    auto pending = *std::next(pages.begin());
+    auto dense = *std::next(pages.begin(), 2);
+
+    // the lowest page is emptied, and becomes the spare. what's left on the
+    // next one is all freed remotely, and still pending when compaction
+    // starts, so that page looks like it has objects to move, but taking in
+    // those frees empties it too. the page after that is kept full, so that
+    // it's never evacuated, and the rest are left a quarter full.
+    std::vector<pointer<numeric>> remote;
+    std::vector<pointer<numeric>> racing;
+    for (auto index = 0; index < count; index++) {
+      auto at = page(ptrs[index]);
+      if (at == pending && index % 16 == 0) {
+        remote.push_back(std::move(ptrs[index]));
+      } else if (at == dense && index % 2) {
+        racing.push_back(std::move(ptrs[index]));
+      } else if (at == spare || at == pending || (at != dense && index % 4)) {
+        _allocator->destroy(ptrs[index]);
+      }
+    }
+
+    std::thread freeing{[&]() {
+      remote.clear();
+    }};
+    freeing.join();
+
+    // more frees come in while the pages are being evacuated. they're of
+    // objects on the full page, which stays put even with half of them gone,
+    // and are only taken in once it's done.
+    std::thread racer{[&]() {
+      racing.clear();
+    }};
+    EXPECT_GT(_allocator->compact(), 0);
+    racer.join();
+    _allocator->drain();
+
+    auto live = 0lu;
+    for (auto index = 0; index < count; index++) {
+      if (ptrs[index]) {
+        live++;
+        EXPECT_EQ(ptrs[index]->_a, index);
+        EXPECT_EQ(ptrs[index]->_b, -index);
+        EXPECT_EQ(ptrs[index]->_num, 0.5 * index);
+      }
+    }
+    for (auto& statistic : _allocator->statistics()) {
+      if (statistic._size == slab<numeric>) {
+        EXPECT_EQ(statistic._used, live);
+      }
+    }
+
+    // and the allocator is still sound afterwards.
+    for (auto index = 0; index < count; index++) {
+      if (!ptrs[index]) {
+        ptrs[index] = _allocator->create<numeric>(index, -index, 0.5 * index);
+      }
+    }
+    for (auto index = 0; index < count; index++) {
+      EXPECT_EQ(ptrs[index]->_a, index);
+    }
+  }
+
+  TEST_F(MemoryTest, CompactPinnedTest) {
+    std::vector<pointer<counted>> ptrs;
+    for (auto index = 0; index < 4096; index++) {
+      ptrs.push_back(_allocator->create<counted>(index));
+    }
+    auto* kept = &*ptrs[4000];
+    for (auto index = 0; index < 4000; index++) {
+      _allocator->destroy(ptrs[index]);
+    }
+
+    EXPECT_EQ(_allocator->compact(), 0);
+    EXPECT_EQ(&*ptrs[4000], kept);
+    EXPECT_EQ(counted::alive, 96);
+  }
+
+  TEST_F(MemoryTest, RemoteDestroyTest) {
+    constexpr auto count = 1024;
+
+    auto page = [this](pointer<counted>& ptr) {
+      return reinterpret_cast<uintptr_t>(&*ptr) & ~(_allocator->pagesize() - 1);
+    };
+
+    std::vector<pointer<counted>> ptrs;
+    std::set<uintptr_t> pages;
+    for (auto index = 0; index < count; index++) {
+      ptrs.push_back(_allocator->create<counted>(index));
+      pages.insert(page(ptrs.back()));
+    }
+
+    std::thread remote{[&]() {
+      ptrs.clear();
+    }};
+    remote.join();
+    EXPECT_EQ(counted::alive, 0);
+
+    // the slots come back to the owner on its next creation.
+    for (auto index = 0; index < count; index++) {
+      ptrs.push_back(_allocator->create<counted>(index));
+      EXPECT_EQ(pages.count(page(ptrs.back())), 1);
+    }
+  }
+
+  TEST_F(MemoryTest, ConcurrentRemoteDestroyTest) {
+    constexpr auto threads = 4;
+    constexpr auto rounds = 64;
+    constexpr auto count = 256;
+
+    for (auto round = 0; round < rounds; round++) {
+      std::vector<std::vector<pointer<counted>>> batches(threads);
+      for (auto& batch : batches) {
+        for (auto index = 0; index < count; index++) {
+          batch.push_back(_allocator->create<counted>(index));
+        }
+      }
+
+      std::vector<std::thread> remotes;
+      for (auto& batch : batches) {
+        remotes.emplace_back([&batch]() {
+          batch.clear();
+        });
+      }
+
+      // keep creating on the owning thread while the others free.
+      std::vector<pointer<counted>> local;
+      for (auto index = 0; index < count; index++) {
+        local.push_back(_allocator->create<counted>(-index));
+      }
+
+      for (auto& remote : remotes) {
+        remote.join();
+      }
+      EXPECT_EQ(counted::alive, count);
+    }
+
+    _allocator->drain();
+    EXPECT_EQ(counted::alive, 0);
+  }
+
+  TEST_F(MemoryTest, BulkCreateTest) {
+    constexpr auto count = 3000;
+
+    auto ptrs = _allocator->create_n<numeric>(count, 1, 2, 3.);
+    ASSERT_EQ(ptrs.size(), count);
+
+    // runs only ever break where one page ends and the next begins.
+    std::set<uintptr_t> pages;
+    auto breaks = 0;
+    for (auto index = 0; index < count; index++) {
+      EXPECT_EQ(ptrs[index]->_a, 1);
+      EXPECT_EQ(ptrs[index]->_b, 2);
+      EXPECT_EQ(ptrs[index]->_num, 3.);
+      pages.insert(reinterpret_cast<uintptr_t>(&*ptrs[index]) & ~(_allocator->pagesize() - 1));
+      if (index > 0) {
+        auto* previous = reinterpret_cast<std::byte*>(&*ptrs[index - 1]);
+        auto* current = reinterpret_cast<std::byte*>(&*ptrs[index]);
+        auto stride = reinterpret_cast<std::byte*>(&*ptrs[1]) - reinterpret_cast<std::byte*>(&*ptrs[0]);
+        if (current - previous != stride) {
+          ++breaks;
+        }
+      }
+    }
+    EXPECT_GT(pages.size(), 1);
+    EXPECT_EQ(breaks, pages.size() - 1);
+  }
+
+  TEST_F(MemoryTest, BulkDestroyTest) {
+    auto ptrs = _allocator->create_n<counted>(100, 7);
+    auto* lowest = &*ptrs.front();
+    auto cpy = ptrs[50];
+    EXPECT_EQ(counted::alive, 100);
+
+    _allocator->destroy_n(ptrs);
+    EXPECT_EQ(counted::alive, 0);
+    EXPECT_FALSE(cpy);
+    for (auto& ptr : ptrs) {
+      EXPECT_FALSE(ptr);
+    }
+
+    // the whole batch was uncarved, so the next one lands in the same place.
+    auto again = _allocator->create_n<counted>(100, 9);
+    EXPECT_EQ(&*again.front(), lowest);
+    EXPECT_EQ(again.back()->_value, 9);
+  }
+
+  TEST_F(MemoryTest, BulkPagesDestroyTest) {
+    constexpr auto count = 4096;
+
+    auto pages = [this](std::vector<pointer<counted>>& ptrs) {
+      std::set<uintptr_t> result;
+      for (auto& ptr : ptrs) {
+        result.insert(reinterpret_cast<uintptr_t>(&*ptr) & ~(_allocator->pagesize() - 1));
+      }
+      return result;
+    };
+
+    auto ptrs = _allocator->create_n<counted>(count, 1);
+    auto before = pages(ptrs);
+    EXPECT_GT(before.size(), 2);
+
+    _allocator->destroy_n(ptrs);
+    EXPECT_EQ(counted::alive, 0);
+
+    auto again = _allocator->create_n<counted>(count, 2);
+    for (auto page : pages(again)) {
+      EXPECT_EQ(before.count(page), 1);
+    }
+    EXPECT_EQ(counted::alive, count);
+  }
+
+  TEST_F(MemoryTest, BulkMixedDestroyTest) {
+    auto ptrs = _allocator->create_n<numeric>(100, 0, 0, 0.);
+    auto* lowest = &*ptrs[1];
+    auto* highest = &*ptrs[99];
+
+    std::vector<pointer<numeric>> odd;
+    for (auto index = 1; index < 100; index += 2) {
+      odd.push_back(ptrs[index]);
+    }
+    std::vector<pointer<numeric>> low{ptrs[10], ptrs[20]};
+    _allocator->destroy_n(low);
+    _allocator->destroy_n(odd);
+
+    // the top slot is uncarved, everything else went to the free tree.
+    auto single = _allocator->create<numeric>(1, 1, 1.);
+    EXPECT_EQ(&*single, lowest);
+    auto run = _allocator->create_n<numeric>(1, 2, 2, 2.);
+    EXPECT_EQ(&*run.front(), highest);
+    for (auto index = 0; index < 100; index += 2) {
+      EXPECT_EQ(static_cast<bool>(ptrs[index]), index != 10 && index != 20);
+    }
+  }
+
+  TEST_F(MemoryTest, BulkRemoteDestroyTest) {
+    auto ptrs = _allocator->create_n<counted>(2048, 3);
+    auto* lowest = &*ptrs.front();
+    for (auto& ptr : ptrs) {
+      lowest = std::min(lowest, &*ptr);
+    }
+
+    std::thread remote{[&]() {
+      _allocator->destroy_n(ptrs);
+    }};
+    remote.join();
+    EXPECT_EQ(counted::alive, 0);
+
+    _allocator->drain();
+    auto single = _allocator->create<counted>(4);
+    EXPECT_EQ(&*single, lowest);
+  }
+
+  TEST_F(MemoryTest, RegionTest) {
+    std::vector<pointer<numeric>> numerics;
+    std::vector<pointer<counted>> counteds;
+    {
+      region scratch{*_allocator};
+      for (auto index = 0; index < 4096; index++) {
+        numerics.push_back(scratch.create<numeric>(index, -index, 0.5));
+        counteds.push_back(scratch.create<counted>(index));
+      }
+      EXPECT_EQ(counted::alive, 4096);
+
+      for (auto index = 0; index < 4096; index++) {
+        EXPECT_EQ(numerics[index]->_a, index);
+        EXPECT_EQ(numerics[index]->_b, -index);
+        EXPECT_EQ(counteds[index]->_value, index);
+      }
+    }
+
+    // the region took everything down with it, handles included.
+    EXPECT_EQ(counted::alive, 0);
+    for (auto index = 0; index < 4096; index++) {
+      EXPECT_FALSE(numerics[index]);
+      EXPECT_FALSE(counteds[index]);
+    }
+  }
+
+  TEST_F(MemoryTest, RegionReleaseTest) {
+    region scratch{*_allocator};
+    {
+      auto ptr = scratch.create<counted>(1);
+      auto cpy = ptr;
+      EXPECT_EQ(counted::alive, 1);
+    }
+    EXPECT_EQ(counted::alive, 0);
+
+    auto kept = scratch.create<counted>(2);
+    auto dropped = scratch.create<counted>(3);
+    _allocator->destroy(dropped);
+    EXPECT_FALSE(dropped);
+    EXPECT_EQ(counted::alive, 1);
+
+    scratch.reset();
+    EXPECT_FALSE(kept);
+    EXPECT_EQ(counted::alive, 0);
+  }
+
+  TEST_F(MemoryTest, RegionRemoteDestroyTest) {
+    constexpr auto threads = 4;
+    constexpr auto count = 256;
+
+    region scratch{*_allocator};
+    std::vector<pointer<counted>> kept;
+    std::vector<std::vector<pointer<counted>>> batches(threads);
+    for (auto index = 0; index < count; index++) {
+      kept.push_back(scratch.create<counted>(index));
+      for (auto& batch : batches) {
+        batch.push_back(scratch.create<counted>(index));
+      }
+    }
+    EXPECT_EQ(counted::alive, (threads + 1) * count);
+
+    // objects dropped elsewhere are finished off right away, and only their
+    // records wait for the owner.
+    std::vector<std::thread> remotes;
+    for (auto& batch : batches) {
+      remotes.emplace_back([&batch]() {
+        batch.clear();
+      });
+    }
+    for (auto& remote : remotes) {
+      remote.join();
+    }
+    EXPECT_EQ(counted::alive, count);
+    for (auto index = 0; index < count; index++) {
+      EXPECT_EQ(kept[index]->_value, index);
+    }
+
+    scratch.reset();
+    EXPECT_EQ(counted::alive, 0);
+    for (auto& ptr : kept) {
+      EXPECT_FALSE(ptr);
+    }
+  }
+
+  TEST_F(MemoryTest, RegionResetTest) {
+    region scratch{*_allocator};
+    auto first = scratch.create<numeric>(1, 1, 1.);
+    auto* address = &*first;
+
+    std::vector<pointer<numeric>> ptrs;
+    for (auto index = 0; index < 2048; index++) {
+      ptrs.push_back(scratch.create<numeric>(index, index, 0.));
+    }
+    scratch.reset();
+    EXPECT_FALSE(first);
+
+    // the chunks are held on to, so the next round starts where the last one
+    // did.
+    auto again = scratch.create<numeric>(2, 2, 2.);
+    EXPECT_EQ(&*again, address);
+    EXPECT_EQ(again->_a, 2);
+
+    // and none of it got in the way of the slabs.
+    auto slabbed = _allocator->create<numeric>(3, 3, 3.);
+    std::vector<pointer<numeric>> batch{slabbed, again};
+    _allocator->destroy_n(batch);
+    EXPECT_FALSE(slabbed);
+    EXPECT_FALSE(again);
+  }
+
+  TEST_F(MemoryTest, StatisticsTest) {
+    auto find = [this]() {
+      for (auto& statistic : _allocator->statistics()) {
+        if (statistic._size == slab<numeric>) {
+          return statistic;
+        }
+      }
+      return allocator::statistic{};
+    };
+
+    EXPECT_EQ(_allocator->statistics().size(), slablist::count);
+    EXPECT_EQ(find()._pages, 0);
+
+    std::vector<pointer<numeric>> ptrs;
+    for (auto index = 0; index < 1000; index++) {
+      ptrs.push_back(_allocator->create<numeric>(index, index, 0.));
+    }
+    auto batch = _allocator->create_n<numeric>(24, 0, 0, 0.);
+
+    auto full = find();
+    EXPECT_EQ(full._created, 1024);
+    EXPECT_EQ(full._destroyed, 0);
+    EXPECT_EQ(full._used, 1024);
+    EXPECT_EQ(full._peak, 1024);
+    EXPECT_EQ(full._bytes, 1024 * slab<numeric>);
+    EXPECT_GT(full._pages, 0);
+    EXPECT_EQ(full._mapped, full._pages * _allocator->pagesize());
+    EXPECT_LT(full._free, full._mapped / slab<numeric>);
+
+    for (auto index = 0; index < 1000; index += 2) {
+      _allocator->destroy(ptrs[index]);
+    }
+    _allocator->destroy_n(batch);
+
+    auto half = find();
+    EXPECT_EQ(half._created, 1024);
+    EXPECT_EQ(half._destroyed, 524);
+    EXPECT_EQ(half._used, 500);
+    EXPECT_EQ(half._peak, 1024);
+    EXPECT_EQ(half._free, full._free + 524);
+
+    // snapshots can be taken from any thread.
+    allocator::statistic remote;
+    std::thread metrics{[&]() {
+      remote = find();
+    }};
+    metrics.join();
+    EXPECT_EQ(remote._used, half._used);
+    EXPECT_EQ(remote._destroyed, half._destroyed);
+  }
+
+  TEST_F(MemoryTest, CompressedTest) {
+    static_assert(sizeof(compressed<numeric>) == 4);
+    static_assert(sizeof(compressed<numeric, widths::bits16>) == 2);
+
+    _allocator = std::make_unique<allocator>(allocator::pagings::small, uint64_t{1} << 32);
+    compressed<numeric>::context context{_allocator->base()};
+    EXPECT_FALSE(compressed<numeric>{});
+
+    std::vector<pointer<numeric>> ptrs;
+    std::vector<compressed<numeric>> refs;
+    for (auto index = 0; index < 4096; index++) {
+      ptrs.push_back(_allocator->create<numeric>(index, -index, 0.5 * index));
+      refs.emplace_back(ptrs.back());
+    }
+
+    for (auto index = 0; index < 4096; index++) {
+      ASSERT_TRUE(refs[index]);
+      EXPECT_EQ(&*refs[index], &*ptrs[index]);
+      EXPECT_EQ(refs[index]->_b, -index);
+      refs[index]->_a = 2 * index;
+      EXPECT_EQ(ptrs[index]->_a, 2 * index);
+    }
+
+    // references pin their size class in place.
+    auto* kept = &*ptrs[4000];
+    for (auto index = 0; index < 4000; index++) {
+      _allocator->destroy(ptrs[index]);
+    }
+    EXPECT_EQ(_allocator->compact(), 0);
+    EXPECT_EQ(&*refs[4000], kept);
+    EXPECT_EQ(refs[4000]->_a, 8000);
+  }
+
+  TEST_F(MemoryTest, CompressedNarrowTest) {
+    using narrow = compressed<counted, widths::bits16>;
+
+    _allocator = std::make_unique<allocator>(allocator::pagings::small, uint64_t{1} << 19);
+    narrow::context context{_allocator->base()};
+
+    std::vector<pointer<counted>> ptrs;
+    std::vector<narrow> refs;
+    for (auto index = 0; index < 1024; index++) {
+      ptrs.push_back(_allocator->create<counted>(index));
+      refs.emplace_back(ptrs.back());
+    }
+    for (auto index = 0; index < 1024; index++) {
+      EXPECT_EQ(refs[index]->_value, index);
+    }
+
+    // pages that were handed back are taken again before the range grows.
+    ptrs.clear();
+    refs.clear();
+    for (auto index = 0; index < 1024; index++) {
+      ptrs.push_back(_allocator->create<counted>(-index));
+      refs.emplace_back(ptrs.back());
+      EXPECT_EQ(refs.back()->_value, -index);
+    }
+  }
+
+  TEST_F(MemoryTest, ReachExhaustedTest) {
+    _allocator = std::make_unique<allocator>(allocator::pagings::small, uint64_t{1} << 19);
+
+    // a small reach runs out, and that has to be an error rather than a page
+    // built at null.
+    std::vector<pointer<uint64_t>> ptrs;
+    EXPECT_THROW({
+      for (;;) {
+        ptrs.push_back(_allocator->create<uint64_t>(ptrs.size()));
+      }
+    }, std::bad_alloc);
+    EXPECT_LT(ptrs.size(), (uint64_t{1} << 19) / sizeof(uint64_t));
+    EXPECT_THROW(_allocator->create_n<uint64_t>(64), std::bad_alloc);
+    for (auto index = 0lu; index < ptrs.size(); index++) {
+      ASSERT_EQ(*ptrs[index], index);
+    }
+
+    // the allocator is still good for whatever room is given back to it.
+    auto kept = ptrs.size();
+    ptrs.resize(kept / 2);
+    for (auto index = kept / 2; index < kept; index++) {
+      ptrs.push_back(_allocator->create<uint64_t>(index));
+    }
+    EXPECT_THROW(_allocator->create<uint64_t>(0lu), std::bad_alloc);
+
+    region scratch{*_allocator};
+    EXPECT_THROW(scratch.create<uint64_t>(0lu), std::bad_alloc);
+  }
+
+  TEST_F(MemoryTest, HugeReservedTest) {
+    _allocator = std::make_unique<allocator>(allocator::pagings::huge, uint64_t{1} << 26);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(_allocator->base()) % allocator::hugepage, 0);
+
+    std::vector<pointer<numeric>> ptrs;
+    for (auto round = 0; round < 3; round++) {
+      ptrs = _allocator->create_n<numeric>(262144, round, round, 0.);
+      for (auto& ptr : ptrs) {
+        EXPECT_GE(reinterpret_cast<std::byte*>(&*ptr), _allocator->base());
+        EXPECT_LT(reinterpret_cast<std::byte*>(&*ptr), _allocator->base() + (uint64_t{1} << 26));
+      }
+    }
+  }
+
+  TEST_F(MemoryTest, HugePageTest) {
+    constexpr auto count = 4096;
+
+    _allocator = std::make_unique<allocator>(allocator::pagings::huge);
+    EXPECT_EQ(_allocator->pagesize(), allocator::hugepage);
+
+    std::vector<pointer<numeric>> ptrs;
+    std::set<uintptr_t> pages;
+    for (auto index = 0; index < count; index++) {
+      ptrs.push_back(_allocator->create<numeric>(index, -index, 0.25 * index));
+      pages.insert(reinterpret_cast<uintptr_t>(&*ptrs.back()) & ~(allocator::hugepage - 1));
+    }
+    EXPECT_EQ(pages.size(), 1);
+
+    for (auto index = 0; index < count; index++) {
+      EXPECT_EQ(ptrs[index]->_a, index);
+      EXPECT_EQ(ptrs[index]->_b, -index);
+      EXPECT_EQ(ptrs[index]->_num, 0.25 * index);
+    }
+
+    auto* lowest = &*ptrs[1];
+    for (auto index = 0; index < count; index++) {
+      if (index % 64) {
+        _allocator->destroy(ptrs[index]);
+      }
+    }
+    EXPECT_EQ(_allocator->compact(), 0);
+
+    auto again = _allocator->create<numeric>(1, 2, 3.);
+    EXPECT_EQ(&*again, lowest);
+  }
+
+  TEST_F(MemoryTest, HugePageRecycleTest) {
+    constexpr auto count = 262144;
+
+    _allocator = std::make_unique<allocator>(allocator::pagings::huge);
+
+    // enough objects to span several huge pages, all of which but the spare
+    // get unmapped once they're empty again.
+    std::vector<pointer<numeric>> ptrs;
+    for (auto round = 0; round < 2; round++) {
+      ptrs.clear();
+      std::set<uintptr_t> pages;
+      for (auto index = 0; index < count; index++) {
+        ptrs.push_back(_allocator->create<numeric>(index, round, 0.));
+        pages.insert(reinterpret_cast<uintptr_t>(&*ptrs.back()) & ~(allocator::hugepage - 1));
+      }
+      EXPECT_GT(pages.size(), 2);
+
+      for (auto index = 0; index < count; index++) {
+        EXPECT_EQ(ptrs[index]->_a, index);
+        EXPECT_EQ(ptrs[index]->_b, round);
+      }
+    }
+  }
+
+  TEST_F(MemoryTest, ManyPagesTest) {
+    constexpr auto count = 4096;
+
+    std::vector<pointer<numeric>> ptrs;
+    ptrs.reserve(count);
+
+    auto num = std::atan(1.);
+    for (auto index = 0; index < count; index++) {
+      ptrs.push_back(_allocator->create<numeric>(2 * index, 2 * index + 1, index * num));
+    }
+
+    std::vector<numeric*> addresses;
+    for (auto& ptr : ptrs) {
+      addresses.push_back(&*ptr);
+    }
+    std::sort(addresses.begin(), addresses.end());
+    EXPECT_EQ(std::adjacent_find(addresses.begin(), addresses.end()), addresses.end());
+
+    for (auto index = 0; index < count; index++) {
+      EXPECT_EQ(ptrs[index]->_a, 2 * index);
+      EXPECT_EQ(ptrs[index]->_b, 2 * index + 1);
+      EXPECT_EQ(ptrs[index]->_num, index * num);
+    }
+
+    for (auto index = 0; index < count; index += 2) {
+      _allocator->destroy(ptrs[index]);
+    }
+    for (auto index = 0; index < count; index += 2) {
+      ptrs[index] = _allocator->create<numeric>(-index, -index, 0.);
+    }
+    for (auto index = 0; index < count; index++) {
+      EXPECT_EQ(ptrs[index]->_a, index % 2 ? 2 * index : -index);
+    }
+  }
+
+}
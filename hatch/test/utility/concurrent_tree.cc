@@ -0,0 +1,184 @@
+#include <hatch/utility/concurrent_tree.hh>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+namespace hatch {
+
+  class ConcurrentTreeTest : public ::testing::Test {
+  public:
+    class test_node : public tree_node<test_node, published> {
+    public:
+      test_node(uint64_t value) :
+          value{value} {
+      }
+
+      bool operator<(const test_node& other) const {
+        return value < other.value;
+      }
+
+      friend bool operator<(const test_node& node, uint64_t value) {
+        return node.value < value;
+      }
+
+      friend bool operator<(uint64_t value, const test_node& node) {
+        return value < node.value;
+      }
+
+      uint64_t value;
+    };
+
+  protected:
+    static constexpr unsigned int count = 1024;
+
+    std::vector<test_node> _nodes;
+    concurrent_tree<test_node> _tree;
+
+    void SetUp() override {
+      _nodes.reserve(count);
+      for (auto value = 0u; value < count; value++) {
+        _nodes.emplace_back(value);
+      }
+    }
+  };
+
+  TEST_F(ConcurrentTreeTest, SimpleTest) {
+    EXPECT_TRUE(_tree.empty());
+    EXPECT_EQ(_tree.find(7lu), nullptr);
+
+    for (auto& node : _nodes) {
+      if (node.value % 2 == 0) {
+        _tree.insert(node);
+      }
+    }
+
+    EXPECT_FALSE(_tree.empty());
+    EXPECT_EQ(_tree.find(8lu), &_nodes[8]);
+    EXPECT_EQ(_tree.find(7lu), nullptr);
+    EXPECT_EQ(_tree.lower_bound(7lu), &_nodes[8]);
+    EXPECT_EQ(_tree.lower_bound(8lu), &_nodes[8]);
+    EXPECT_EQ(_tree.upper_bound(8lu), &_nodes[10]);
+    EXPECT_EQ(_tree.upper_bound(uint64_t{count}), nullptr);
+
+    EXPECT_EQ(_tree.remove(_nodes[8]), &_nodes[8]);
+    _tree.synchronize();
+    EXPECT_EQ(_tree.find(8lu), nullptr);
+    EXPECT_TRUE(_nodes[8].alone());
+  }
+
+  TEST_F(ConcurrentTreeTest, ReadersTest) {
+    // the even nodes stay put while the writer keeps moving the odd ones in
+    // and out, so the readers always know what they should be finding.
+    for (auto& node : _nodes) {
+      if (node.value % 2 == 0) {
+        _tree.insert(node);
+      }
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> failures{0};
+
+    std::vector<std::thread> readers;
+    for (auto reader = 0u; reader < 4; reader++) {
+      readers.emplace_back([&, reader]() {
+        std::mt19937 engine{reader};
+        std::uniform_int_distribution<uint64_t> values{0, count - 3};
+        while (!done.load()) {
+          auto value = values(engine);
+          auto* found = _tree.find(value);
+          if (value % 2 == 0 ? found != &_nodes[value] : found && found != &_nodes[value]) {
+            failures++;
+          }
+          auto* bound = _tree.lower_bound(value | 1);
+          if (bound != &_nodes[value | 1] && bound != &_nodes[(value | 1) + 1]) {
+            failures++;
+          }
+        }
+      });
+    }
+
+    std::vector<unsigned int> order;
+    for (auto value = 1u; value < count; value += 2) {
+      order.push_back(value);
+    }
+
+    std::mt19937 engine{12345};
+    for (auto round = 0u; round < 32; round++) {
+      std::shuffle(order.begin(), order.end(), engine);
+      for (auto value : order) {
+        _tree.insert(_nodes[value]);
+      }
+      std::shuffle(order.begin(), order.end(), engine);
+      for (auto value : order) {
+        _tree.remove(_nodes[value]);
+      }
+    }
+
+    done = true;
+    for (auto& reader : readers) {
+      reader.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0u);
+  }
+
+  TEST_F(ConcurrentTreeTest, SynchronizeTest) {
+    for (auto& node : _nodes) {
+      _tree.insert(node);
+    }
+
+    // the readers hang on to what they find for a while. the writer scribbles
+    // over every node it takes out as soon as synchronize lets it, and puts it
+    // back right after, so a reader that's let go too soon sees the scribble.
+    constexpr auto scribbled = ~uint64_t{0};
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> failures{0};
+
+    std::vector<std::thread> readers;
+    for (auto reader = 0u; reader < 4; reader++) {
+      readers.emplace_back([&, reader]() {
+        std::mt19937 engine{reader};
+        std::uniform_int_distribution<uint64_t> values{0, count - 1};
+        while (!done.load()) {
+          auto value = values(engine);
+          auto guard = _tree.guard();
+          if (auto* found = _tree.find(value)) {
+            for (auto check = 0u; check < 64; check++) {
+              if (found->value != value) {
+                failures++;
+              }
+            }
+          }
+        }
+      });
+    }
+
+    std::mt19937 engine{12345};
+    std::uniform_int_distribution<uint64_t> values{0, count - 1};
+    for (auto round = 0u; round < 128; round++) {
+      auto& node = _nodes[values(engine)];
+      auto value = node.value;
+      _tree.remove(node);
+      _tree.synchronize();
+      node.value = scribbled;
+      std::this_thread::yield();
+      node.value = value;
+      _tree.insert(node);
+    }
+
+    done = true;
+    for (auto& reader : readers) {
+      reader.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0u);
+  }
+
+}
@@ -0,0 +1,165 @@
+#include <hatch/utility/hash_table.hh>
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+
+#include <cstdint>
+
+namespace hatch {
+
+  class HashTableTest : public ::testing::Test {
+  public:
+    class key_of;
+    class test_node;
+
+    class key_of {
+    public:
+      uint64_t operator()(const test_node& node) const;
+    };
+
+    class test_node : public hash_node<test_node, key_of> {
+    public:
+      test_node(uint64_t value) :
+          value{value} {
+      }
+
+      uint64_t value;
+    };
+
+  protected:
+    static constexpr unsigned int count = 1024;
+
+    std::deque<test_node> _nodes;
+    hash_table<test_node, key_of> _table;
+
+    void SetUp() override {
+      for (auto index = 0u; index < count; index++) {
+        _nodes.emplace_back(index * 7);
+      }
+    }
+
+    uint64_t visited() const {
+      auto visited = 0lu;
+      _table.visit([&](const test_node&) { visited++; });
+      return visited;
+    }
+  };
+
+  uint64_t HashTableTest::key_of::operator()(const test_node& node) const {
+    return node.value;
+  }
+
+  TEST_F(HashTableTest, EmptyTest) {
+    EXPECT_TRUE(_table.empty());
+    EXPECT_EQ(_table.size(), 0u);
+    EXPECT_EQ(_table.find(0lu), nullptr);
+    EXPECT_EQ(visited(), 0u);
+  }
+
+  TEST_F(HashTableTest, FindTest) {
+    // every lookup along the way has to see through whatever migration is
+    // under way at the time.
+    for (auto index = 0u; index < count; index++) {
+      _table.insert(_nodes[index]);
+      EXPECT_EQ(_table.find(index * 7lu), &_nodes[index]);
+      EXPECT_EQ(_table.find(index / 2 * 7lu), &_nodes[index / 2]);
+      EXPECT_EQ(_table.find(index * 7lu + 1), nullptr);
+      if (index % 37 == 0) {
+        EXPECT_EQ(visited(), index + 1);
+      }
+    }
+    EXPECT_EQ(_table.size(), count);
+    EXPECT_EQ(visited(), count);
+
+    for (auto index = 0u; index < count; index++) {
+      EXPECT_EQ(_table.find(index * 7lu), &_nodes[index]);
+    }
+  }
+
+  TEST_F(HashTableTest, RemoveTest) {
+    std::mt19937 engine{12345};
+    std::uniform_int_distribution<unsigned int> indices{0, count - 1};
+
+    // removals are mixed in with the insertions, so plenty of them land on
+    // buckets that haven't been carried over yet.
+    auto inserted = 0u;
+    for (auto index = 0u; index < count; index++) {
+      _table.insert(_nodes[index]);
+      inserted++;
+      if (index % 3 == 0) {
+        auto removed = indices(engine) % (index + 1);
+        if (_table.find(_nodes[removed].value)) {
+          EXPECT_EQ(_table.remove(_nodes[removed]), &_nodes[removed]);
+          EXPECT_EQ(_table.find(_nodes[removed].value), nullptr);
+          inserted--;
+        }
+      }
+    }
+    EXPECT_EQ(_table.size(), inserted);
+    EXPECT_EQ(visited(), inserted);
+
+    for (auto& node : _nodes) {
+      if (_table.find(node.value)) {
+        _table.remove(node);
+      }
+    }
+    EXPECT_TRUE(_table.empty());
+    EXPECT_EQ(visited(), 0u);
+  }
+
+  TEST_F(HashTableTest, DuplicateTest) {
+    std::deque<test_node> duplicates;
+    for (auto index = 0u; index < count; index++) {
+      duplicates.emplace_back(index % 16);
+    }
+    for (auto& node : duplicates) {
+      _table.insert(node);
+    }
+    EXPECT_EQ(_table.size(), count);
+
+    // each key stays findable until the last node with it is gone.
+    for (auto index = 0u; index < count; index++) {
+      EXPECT_NE(_table.find(index % 16lu), nullptr);
+      _table.remove(duplicates[index]);
+    }
+    for (auto key = 0lu; key < 16; key++) {
+      EXPECT_EQ(_table.find(key), nullptr);
+    }
+    EXPECT_TRUE(_table.empty());
+  }
+
+  TEST_F(HashTableTest, MoveTest) {
+    for (auto& node : _nodes) {
+      _table.insert(node);
+    }
+
+    hash_table<test_node, key_of> moved{std::move(_table)};
+    EXPECT_TRUE(_table.empty());
+    EXPECT_EQ(_table.find(7lu), nullptr);
+    EXPECT_EQ(moved.size(), count);
+    EXPECT_EQ(moved.find(7lu), &_nodes[1]);
+
+    _table = std::move(moved);
+    EXPECT_EQ(_table.size(), count);
+    EXPECT_EQ(_table.find(14lu), &_nodes[2]);
+  }
+
+  TEST_F(HashTableTest, ClearTest) {
+    for (auto& node : _nodes) {
+      _table.insert(node);
+    }
+    _table.clear();
+    EXPECT_TRUE(_table.empty());
+    EXPECT_EQ(visited(), 0u);
+    EXPECT_EQ(_table.find(7lu), nullptr);
+
+    // the nodes are free to go back in.
+    for (auto& node : _nodes) {
+      _table.insert(node);
+    }
+    EXPECT_EQ(_table.size(), count);
+    EXPECT_EQ(visited(), count);
+  }
+
+}
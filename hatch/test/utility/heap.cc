@@ -0,0 +1,148 @@
+#include <hatch/utility/heap.hh>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <cstdint>
+
+namespace hatch {
+
+  class HeapTest : public ::testing::Test {
+  public:
+    class test_node : public heap_node<test_node> {
+    public:
+      test_node(uint64_t value) :
+          value{value} {
+      }
+
+      bool operator<(const test_node& other) const {
+        return value < other.value;
+      }
+
+      uint64_t value;
+    };
+
+  protected:
+    static constexpr unsigned int count = 1024;
+
+    std::deque<test_node> _nodes;
+    heap<test_node> _heap;
+
+    void SetUp() override {
+      std::mt19937 engine{12345};
+      std::uniform_int_distribution<uint64_t> values{0, 4 * count};
+      for (auto index = 0u; index < count; index++) {
+        _nodes.emplace_back(values(engine));
+      }
+    }
+
+    // pops everything, checking that it comes out in order.
+    uint64_t drain() {
+      auto popped = 0lu;
+      auto previous = 0lu;
+      while (auto* node = _heap.pop()) {
+        EXPECT_LE(previous, node->value);
+        EXPECT_TRUE(node->alone());
+        previous = node->value;
+        popped++;
+      }
+      return popped;
+    }
+  };
+
+  TEST_F(HeapTest, EmptyTest) {
+    EXPECT_TRUE(_heap.empty());
+    EXPECT_EQ(_heap.size(), 0u);
+    EXPECT_EQ(_heap.top(), nullptr);
+    EXPECT_EQ(_heap.pop(), nullptr);
+  }
+
+  TEST_F(HeapTest, PopTest) {
+    for (auto& node : _nodes) {
+      _heap.insert(node);
+    }
+    EXPECT_EQ(_heap.size(), count);
+
+    auto least = std::min_element(_nodes.begin(), _nodes.end());
+    EXPECT_EQ(_heap.top()->value, least->value);
+
+    EXPECT_EQ(drain(), count);
+    EXPECT_TRUE(_heap.empty());
+  }
+
+  TEST_F(HeapTest, RemoveTest) {
+    for (auto& node : _nodes) {
+      _heap.insert(node);
+    }
+    _heap.pop();
+
+    // pull out every other node from wherever it's ended up.
+    auto removed = 0lu;
+    for (auto index = 0u; index < count; index += 2) {
+      if (!_nodes[index].alone()) {
+        EXPECT_EQ(_heap.remove(_nodes[index]), &_nodes[index]);
+        EXPECT_TRUE(_nodes[index].alone());
+        removed++;
+      }
+    }
+    EXPECT_EQ(_heap.size(), count - 1 - removed);
+    EXPECT_EQ(drain(), count - 1 - removed);
+  }
+
+  TEST_F(HeapTest, DecreaseTest) {
+    for (auto& node : _nodes) {
+      _heap.insert(node);
+    }
+    _heap.pop();
+
+    for (auto index = 1u; index < count; index += 3) {
+      _nodes[index].value /= 2;
+      if (!_nodes[index].alone()) {
+        _heap.decrease(_nodes[index]);
+      }
+    }
+    _nodes[count / 2].value = 0;
+    if (!_nodes[count / 2].alone()) {
+      _heap.decrease(_nodes[count / 2]);
+      EXPECT_EQ(_heap.top(), &_nodes[count / 2]);
+    }
+
+    for (auto index = 2u; index < count; index += 5) {
+      _nodes[index].value *= 3;
+      if (!_nodes[index].alone()) {
+        _heap.update(_nodes[index]);
+      }
+    }
+
+    EXPECT_EQ(drain(), count - 1);
+  }
+
+  TEST_F(HeapTest, MergeTest) {
+    heap<test_node> other;
+    for (auto index = 0u; index < count; index++) {
+      (index % 2 ? _heap : other).insert(_nodes[index]);
+    }
+
+    _heap.merge(other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(_heap.size(), count);
+    EXPECT_EQ(drain(), count);
+  }
+
+  TEST_F(HeapTest, ClearTest) {
+    for (auto& node : _nodes) {
+      _heap.insert(node);
+    }
+    _heap.pop();
+    _heap.clear();
+
+    EXPECT_TRUE(_heap.empty());
+    for (auto& node : _nodes) {
+      EXPECT_TRUE(node.alone());
+    }
+  }
+
+}
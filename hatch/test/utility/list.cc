@@ -296,6 +296,42 @@ namespace hatch {
     EXPECT_EQ(dump(one), 0);
   }
 
+  TEST_F(ListTest, FourElementRemoveTest) {
+    one.push_back(first);
+    one.push_back(second);
+    one.push_back(third);
+    one.push_back(fourth);
+
+    object = one.remove(second);
+
+    EXPECT_EQ(object, &second);
+    EXPECT_TRUE(second.alone());
+    EXPECT_EQ(dump(one), 3);
+    EXPECT_EQ(data[0].numerator, 1);
+    EXPECT_EQ(data[1].numerator, 3);
+    EXPECT_EQ(data[2].numerator, 4);
+
+    object = one.remove(first);
+
+    EXPECT_EQ(object, &first);
+    EXPECT_TRUE(first.alone());
+    EXPECT_EQ(one.front(), &third);
+    EXPECT_EQ(dump(one), 2);
+
+    object = one.remove(fourth);
+
+    EXPECT_EQ(object, &fourth);
+    EXPECT_TRUE(fourth.alone());
+    EXPECT_TRUE(third.alone());
+    EXPECT_EQ(dump(one), 1);
+
+    object = one.remove(third);
+
+    EXPECT_EQ(object, &third);
+    EXPECT_TRUE(one.empty());
+    EXPECT_EQ(dump(one), 0);
+  }
+
   TEST_F(ListTest, OneListFrontTest) {
     two.push_front(third);
 
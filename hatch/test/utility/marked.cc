@@ -0,0 +1,64 @@
+#include <hatch/utility/marked.hh>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+namespace hatch {
+
+  class MarkedTest : public ::testing::Test {
+  protected:
+    using test_pair = std::pair<int16_t, int16_t>;
+
+    test_pair _data;
+    test_pair _other;
+
+    void SetUp() override {
+      _data.first = 12;
+      _data.second = 987;
+      _other.first = 34;
+      _other.second = 654;
+    }
+
+  };
+
+  TEST_F(MarkedTest, SanityTest) {
+    marked<test_pair> ptr;
+
+    EXPECT_FALSE(ptr);
+    EXPECT_FALSE(ptr.tag());
+
+    ptr = &_data;
+
+    EXPECT_EQ(ptr->first, 12);
+    EXPECT_EQ(ptr->second, 987);
+  }
+
+  TEST_F(MarkedTest, TagTest) {
+    marked<test_pair> ptr;
+
+    ptr.make_tag(true);
+    EXPECT_FALSE(ptr);
+    EXPECT_TRUE(ptr.tag());
+
+    ptr = &_data;
+    EXPECT_TRUE(ptr.tag());
+    EXPECT_EQ(ptr->second, 987);
+
+    marked<test_pair> copy{ptr};
+    EXPECT_FALSE(copy.tag());
+    EXPECT_EQ(&*copy, &_data);
+
+    copy = &_other;
+    ptr = copy;
+    EXPECT_TRUE(ptr.tag());
+    EXPECT_EQ(ptr->first, 34);
+
+    ptr.make_tag(false);
+    EXPECT_FALSE(ptr.tag());
+    EXPECT_EQ(&*ptr, &_other);
+
+    ptr = nullptr;
+    EXPECT_FALSE(ptr);
+  }
+
+}
@@ -0,0 +1,199 @@
+#include <hatch/utility/skiplist.hh>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+namespace hatch {
+
+  class SkiplistTest : public ::testing::Test {
+  public:
+    class test_node : public skiplist_node<test_node> {
+    public:
+      test_node(uint64_t value) :
+          value{value} {
+      }
+
+      bool operator<(const test_node& other) const {
+        return value < other.value;
+      }
+
+      friend bool operator<(const test_node& node, uint64_t value) {
+        return node.value < value;
+      }
+
+      friend bool operator<(uint64_t value, const test_node& node) {
+        return value < node.value;
+      }
+
+      uint64_t value;
+    };
+
+  protected:
+    static constexpr unsigned int count = 1024;
+
+    // the nodes can't move once they might be in the list.
+    std::deque<test_node> _nodes;
+    skiplist<test_node> _list;
+
+    void SetUp() override {
+      for (auto value = 0u; value < count; value++) {
+        _nodes.emplace_back(value);
+      }
+    }
+
+    std::vector<uint64_t> values() const {
+      std::vector<uint64_t> values;
+      for (auto& node : _list) {
+        values.push_back(node.value);
+      }
+      return values;
+    }
+  };
+
+  TEST_F(SkiplistTest, EmptyTest) {
+    EXPECT_TRUE(_list.empty());
+    EXPECT_EQ(_list.begin(), _list.end());
+    EXPECT_EQ(_list.front(), nullptr);
+    EXPECT_EQ(_list.pop(), nullptr);
+    EXPECT_FALSE(_list.find(3lu));
+  }
+
+  TEST_F(SkiplistTest, OrderTest) {
+    std::vector<unsigned int> order(count);
+    for (auto index = 0u; index < count; index++) {
+      order[index] = index;
+    }
+
+    std::mt19937 engine{12345};
+    std::shuffle(order.begin(), order.end(), engine);
+    for (auto index : order) {
+      if (index % 2 == 0) {
+        _list.insert(_nodes[index]);
+      }
+    }
+
+    auto found = values();
+    EXPECT_EQ(found.size(), count / 2);
+    EXPECT_TRUE(std::is_sorted(found.begin(), found.end()));
+
+    EXPECT_EQ(&*_list.find(64lu), &_nodes[64]);
+    EXPECT_FALSE(_list.find(65lu));
+    EXPECT_EQ(_list.lower_bound(65lu)->value, 66u);
+    EXPECT_EQ(_list.lower_bound(66lu)->value, 66u);
+    EXPECT_EQ(_list.upper_bound(66lu)->value, 68u);
+    EXPECT_FALSE(_list.upper_bound(uint64_t{count}));
+    EXPECT_EQ(_list.front(), &_nodes[0]);
+
+    std::shuffle(order.begin(), order.end(), engine);
+    auto remaining = count / 2;
+    for (auto index : order) {
+      if (index % 2 == 0) {
+        EXPECT_TRUE(_list.remove(_nodes[index]));
+        EXPECT_FALSE(_list.remove(_nodes[index]));
+        EXPECT_FALSE(_list.find(uint64_t{index}));
+        remaining--;
+      }
+    }
+    EXPECT_EQ(remaining, 0u);
+    EXPECT_TRUE(_list.empty());
+  }
+
+  TEST_F(SkiplistTest, DuplicateTest) {
+    test_node first{7};
+    test_node second{7};
+    test_node third{7};
+
+    _list.insert(_nodes[8]);
+    _list.insert(first);
+    _list.insert(_nodes[6]);
+    _list.insert(second);
+    _list.insert(third);
+
+    EXPECT_EQ(values(), (std::vector<uint64_t>{6, 7, 7, 7, 8}));
+    EXPECT_EQ(_list.lower_bound(7lu)->value, 7u);
+    EXPECT_EQ(_list.upper_bound(7lu)->value, 8u);
+
+    EXPECT_TRUE(_list.remove(second));
+    EXPECT_EQ(values(), (std::vector<uint64_t>{6, 7, 7, 8}));
+    _list.clear();
+  }
+
+  TEST_F(SkiplistTest, PopTest) {
+    for (auto index = count; index-- > 0;) {
+      _list.insert(_nodes[index]);
+    }
+    for (auto index = 0u; index < count; index++) {
+      EXPECT_EQ(_list.pop(), &_nodes[index]);
+    }
+    EXPECT_EQ(_list.pop(), nullptr);
+  }
+
+  TEST_F(SkiplistTest, ConcurrentTest) {
+    // every thread inserts its own share and then pops as many as it put in;
+    // between them, every node has to come out exactly once.
+    constexpr auto threads = 4u;
+
+    std::vector<std::atomic<uint64_t>> popped(count);
+    std::vector<std::thread> workers;
+    for (auto thread = 0u; thread < threads; thread++) {
+      workers.emplace_back([&, thread]() {
+        for (auto index = thread; index < count; index += threads) {
+          _list.insert(_nodes[index]);
+        }
+        for (auto index = thread; index < count; index += threads) {
+          if (auto* node = _list.pop()) {
+            popped[node->value]++;
+          }
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    EXPECT_TRUE(_list.empty());
+    for (auto index = 0u; index < count; index++) {
+      EXPECT_EQ(popped[index].load(), 1u);
+    }
+  }
+
+  TEST_F(SkiplistTest, ReuseTest) {
+    // nodes are popped while they may still be going up their towers. once
+    // all the threads are done, nothing may be left linking to any of them,
+    // so they can all go back in and come out in order.
+    constexpr auto threads = 4u;
+
+    for (auto round = 0u; round < 16; round++) {
+      std::vector<std::thread> workers;
+      for (auto thread = 0u; thread < threads; thread++) {
+        workers.emplace_back([&, thread]() {
+          for (auto index = thread; index < count; index += threads) {
+            _list.insert(_nodes[index]);
+            _list.pop();
+          }
+        });
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
+      while (_list.pop()) {
+      }
+
+      for (auto index = count; index-- > 0;) {
+        _list.insert(_nodes[index]);
+      }
+      for (auto index = 0u; index < count; index++) {
+        ASSERT_EQ(_list.pop(), &_nodes[index]);
+      }
+      ASSERT_TRUE(_list.empty());
+    }
+  }
+
+}
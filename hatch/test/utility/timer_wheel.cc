@@ -0,0 +1,151 @@
+#include <hatch/utility/timer_wheel.hh>
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <cstdint>
+
+namespace hatch {
+
+  class TimerWheelTest : public ::testing::Test {
+  public:
+    class test_timer : public timer_node<test_timer> {
+    public:
+      test_timer(uint64_t id) :
+          id{id}, fired{0} {
+      }
+
+      uint64_t id;
+      uint64_t fired;
+    };
+
+  protected:
+    static constexpr unsigned int count = 1024;
+
+    std::deque<test_timer> _timers;
+    timer_wheel<test_timer, 4, 3> _wheel;
+
+    void SetUp() override {
+      for (auto id = 0u; id < count; id++) {
+        _timers.emplace_back(id);
+      }
+    }
+  };
+
+  TEST_F(TimerWheelTest, FireTest) {
+    // deadlines spread over every wheel and past the top one, checked against
+    // the tick each timer actually fires on.
+    std::mt19937 engine{12345};
+    std::uniform_int_distribution<uint64_t> deadlines{1, 10000};
+    for (auto& timer : _timers) {
+      _wheel.arm(timer, deadlines(engine));
+      EXPECT_TRUE(timer.armed());
+    }
+
+    auto fired = 0lu;
+    for (auto now = 0lu; now <= 10000; now += 7) {
+      _wheel.advance(now, [&](test_timer& timer) {
+        EXPECT_EQ(timer.deadline(), _wheel.now());
+        EXPECT_FALSE(timer.armed());
+        timer.fired++;
+        fired++;
+      });
+    }
+    _wheel.advance(10001, [&](test_timer&) {
+      fired++;
+    });
+
+    EXPECT_EQ(fired, count);
+    for (auto& timer : _timers) {
+      EXPECT_EQ(timer.fired, 1u);
+    }
+  }
+
+  TEST_F(TimerWheelTest, CancelTest) {
+    for (auto& timer : _timers) {
+      _wheel.arm(timer, 100 + timer.id);
+    }
+    for (auto& timer : _timers) {
+      if (timer.id % 3 != 0) {
+        EXPECT_EQ(_wheel.cancel(timer), &timer);
+        EXPECT_FALSE(timer.armed());
+        EXPECT_TRUE(timer.alone());
+      }
+    }
+
+    auto fired = 0lu;
+    _wheel.advance(100 + count, [&](test_timer& timer) {
+      EXPECT_EQ(timer.id % 3, 0u);
+      fired++;
+    });
+    EXPECT_EQ(fired, (count + 2) / 3);
+  }
+
+  TEST_F(TimerWheelTest, RearmTest) {
+    // a timer that arms itself again as it fires, and one that moves another.
+    auto& periodic = _timers[0];
+    auto& moved = _timers[1];
+    auto& late = _timers[2];
+
+    _wheel.arm(periodic, 10);
+    _wheel.arm(moved, 50);
+    _wheel.advance(5, [](test_timer&) {
+      FAIL();
+    });
+
+    // a deadline that has passed fires on the next tick.
+    _wheel.arm(late, 3);
+
+    std::vector<uint64_t> ticks;
+    _wheel.advance(100, [&](test_timer& timer) {
+      ticks.push_back(_wheel.now());
+      if (&timer == &periodic && _wheel.now() < 40) {
+        _wheel.arm(periodic, _wheel.now() + 10);
+        _wheel.arm(moved, _wheel.now() + 15);
+      }
+    });
+
+    EXPECT_EQ(ticks, (std::vector<uint64_t>{6, 10, 20, 30, 40, 45}));
+  }
+
+  TEST_F(TimerWheelTest, WrapTest) {
+    // a timer armed again a whole turn of the bottom wheel later, from its last
+    // slot, lands on the slot it's firing from.
+    timer_wheel<test_timer> wheel;
+    auto& periodic = _timers[0];
+    auto& cancelled = _timers[1];
+    wheel.arm(periodic, 63);
+    wheel.arm(cancelled, 63);
+
+    std::vector<uint64_t> ticks;
+    wheel.advance(1000, [&](test_timer& timer) {
+      EXPECT_EQ(timer.deadline(), wheel.now());
+      ticks.push_back(wheel.now());
+      wheel.cancel(cancelled);
+      if (ticks.size() < 4) {
+        wheel.arm(timer, wheel.now() + 64);
+      }
+    });
+
+    EXPECT_EQ(ticks, (std::vector<uint64_t>{63, 127, 191, 255}));
+    EXPECT_FALSE(cancelled.armed());
+  }
+
+  TEST_F(TimerWheelTest, DestroyTest) {
+    auto doomed = std::make_unique<test_timer>(count);
+    _wheel.arm(*doomed, 20);
+    _wheel.arm(_timers[0], 20);
+    doomed.reset();
+
+    auto fired = 0lu;
+    _wheel.advance(20, [&](test_timer& timer) {
+      EXPECT_EQ(&timer, &_timers[0]);
+      fired++;
+    });
+    EXPECT_EQ(fired, 1u);
+  }
+
+}
@@ -1,7 +1,10 @@
 #include <hatch/utility/tree.hh>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <random>
 #include <sstream>
 
 #include <cstdint>
@@ -211,4 +214,655 @@ namespace hatch {
     }
   }
 
-} // namespace hatch
\ No newline at end of file
+  TEST_F(TreeTest, ShuffledTree) {
+    std::vector<unsigned int> order(count);
+    for (auto index = 0u; index < count; index++) {
+      order[index] = index;
+    }
+
+    std::mt19937 engine{12345};
+    std::shuffle(order.begin(), order.end(), engine);
+    for (auto index : order) {
+      _tree.insert(_nodes[index]);
+    }
+
+    std::shuffle(order.begin(), order.end(), engine);
+    for (auto removed = 0u; removed < count; removed++) {
+      try {
+        _tree.root()->get().black_depth();
+      } catch (const test_failure& failure) {
+        std::stringstream message{};
+        message << "rb failure: " << failure;
+        FAIL() << message.str();
+      }
+
+      uint64_t previous = 0;
+      auto remaining = 0u;
+      for (auto& node : _tree) {
+        if (remaining++ > 0) {
+          EXPECT_LT(previous, node.value);
+        }
+        previous = node.value;
+      }
+      EXPECT_EQ(remaining, count - removed);
+
+      EXPECT_EQ(_tree.remove(_nodes[order[removed]]), &_nodes[order[removed]]);
+      EXPECT_TRUE(_nodes[order[removed]].alone());
+    }
+
+    EXPECT_TRUE(_tree.empty());
+  }
+
+  TEST_F(TreeTest, AssignSortedTest) {
+    // every count up to a few levels deep, so both full and partial bottom
+    // levels come up.
+    for (auto size = 0u; size <= count; size++) {
+      _tree.assign_sorted(_nodes.begin(), _nodes.begin() + size);
+
+      if (size) {
+        EXPECT_TRUE(_tree.root()->is_black());
+        try {
+          _tree.root()->get().black_depth();
+        } catch (const test_failure& failure) {
+          std::stringstream message{};
+          message << "rb failure at " << size << ": " << failure;
+          FAIL() << message.str();
+        }
+      }
+
+      auto expected = 0u;
+      for (auto& node : _tree) {
+        EXPECT_EQ(node.value, expected++);
+      }
+      EXPECT_EQ(expected, size);
+    }
+
+    // the tree has to behave like any other afterwards.
+    std::vector<unsigned int> order(count);
+    for (auto index = 0u; index < count; index++) {
+      order[index] = index;
+    }
+    std::mt19937 engine{11235};
+    std::shuffle(order.begin(), order.end(), engine);
+    for (auto index : order) {
+      _tree.remove(_nodes[index]);
+      if (!_tree.empty()) {
+        _tree.root()->get().black_depth();
+      }
+    }
+    EXPECT_TRUE(_tree.empty());
+  }
+
+  TEST_F(TreeTest, SplitJoinTest) {
+    auto check = [](tree<test_node>& checked, uint64_t first, uint64_t last) {
+      if (!checked.empty()) {
+        EXPECT_TRUE(checked.root()->is_black());
+        checked.root()->get().black_depth();
+      }
+      auto expected = first;
+      for (auto& node : checked) {
+        EXPECT_EQ(node.value, expected++);
+      }
+      EXPECT_EQ(expected, last);
+    };
+
+    std::vector<unsigned int> order(count);
+    for (auto index = 0u; index < count; index++) {
+      order[index] = index;
+    }
+    std::mt19937 engine{31415};
+    std::shuffle(order.begin(), order.end(), engine);
+    for (auto index : order) {
+      _tree.insert(_nodes[index]);
+    }
+
+    // split everywhere, including past both ends, and put it back together.
+    // near the ends, the two sides differ a lot in height.
+    for (auto at = 0u; at <= count + 1; at++) {
+      try {
+        test_node key{at};
+        auto [lower, upper] = _tree.split(key);
+        EXPECT_TRUE(_tree.empty());
+        check(lower, 0, std::min(at, count));
+        check(upper, std::min(at, count), count);
+
+        _tree = tree<test_node>::join(std::move(lower), std::move(upper));
+        EXPECT_TRUE(lower.empty());
+        EXPECT_TRUE(upper.empty());
+        check(_tree, 0, count);
+      } catch (const test_failure& failure) {
+        std::stringstream message{};
+        message << "rb failure at " << at << ": " << failure;
+        FAIL() << message.str();
+      }
+    }
+  }
+
+  class TreeKeyTest : public ::testing::Test {
+  public:
+    class test_timer;
+
+    class deadline_of {
+    public:
+      uint64_t operator()(const test_timer& timer) const;
+    };
+
+    class id_of {
+    public:
+      uint64_t operator()(const test_timer& timer) const;
+    };
+
+    using by_deadline = tree_node<test_timer, pointed, deadline_of>;
+    using by_id = tree_node<test_timer, pointed, id_of, std::greater<>>;
+
+    class test_timer : public by_deadline, public by_id {
+    public:
+      test_timer(uint64_t deadline, uint64_t id) :
+          deadline{deadline},
+          id{id} {
+      }
+
+      uint64_t deadline;
+      uint64_t id;
+    };
+
+  protected:
+    static constexpr unsigned int count = 64;
+
+    std::vector<test_timer> _timers;
+    tree<test_timer, pointed, deadline_of> _deadlines;
+    tree<test_timer, pointed, id_of, std::greater<>> _ids;
+
+    void SetUp() override {
+      _timers.reserve(count);
+      for (auto index = 0u; index < count; index++) {
+        _timers.emplace_back((index * 37) % count, index);
+      }
+    }
+  };
+
+  uint64_t TreeKeyTest::deadline_of::operator()(const test_timer& timer) const {
+    return timer.deadline;
+  }
+
+  uint64_t TreeKeyTest::id_of::operator()(const test_timer& timer) const {
+    return timer.id;
+  }
+
+  TEST_F(TreeKeyTest, TwoOrdersTest) {
+    for (auto& timer : _timers) {
+      _deadlines.insert(timer);
+      _ids.insert(timer);
+    }
+
+    auto deadline = 0u;
+    for (auto& timer : _deadlines) {
+      EXPECT_EQ(timer.deadline, deadline++);
+    }
+    EXPECT_EQ(deadline, count);
+
+    auto id = count;
+    for (auto& timer : _ids) {
+      EXPECT_EQ(timer.id, --id);
+    }
+    EXPECT_EQ(id, 0);
+
+    // taking a timer out of one order leaves it in the other.
+    _deadlines.remove(_timers[5]);
+    EXPECT_TRUE(_timers[5].by_deadline::alone());
+    EXPECT_FALSE(_timers[5].by_id::alone());
+    EXPECT_EQ(&*_ids.find(uint64_t{5}), &_timers[5]);
+  }
+
+  TEST_F(TreeKeyTest, BareKeyFindTest) {
+    for (auto& timer : _timers) {
+      _deadlines.insert(timer);
+      _ids.insert(timer);
+    }
+
+    for (auto key = 0u; key < count; key++) {
+      auto found = _deadlines.find(uint64_t{key});
+      ASSERT_NE(found, _deadlines.end());
+      EXPECT_EQ(found->deadline, key);
+      EXPECT_EQ(_ids.find(key)->id, key);
+    }
+    EXPECT_EQ(_deadlines.find(uint64_t{count}), _deadlines.end());
+    EXPECT_EQ(_ids.find(count + 1), _ids.end());
+
+    // looking up by node still goes by the node's key.
+    EXPECT_EQ(&*_deadlines.find(_timers[7]), &_timers[7]);
+  }
+
+  TEST_F(TreeKeyTest, BoundsTest) {
+    for (auto& timer : _timers) {
+      _deadlines.insert(timer);
+    }
+
+    // a range scan only visits what's in the range.
+    auto scanned = 0u;
+    auto end = _deadlines.lower_bound(uint64_t{20});
+    for (auto each = _deadlines.lower_bound(uint64_t{10}); each != end; ++each) {
+      EXPECT_EQ(each->deadline, 10 + scanned++);
+    }
+    EXPECT_EQ(scanned, 10);
+
+    EXPECT_EQ(_deadlines.lower_bound(uint64_t{0})->deadline, 0);
+    EXPECT_EQ(_deadlines.upper_bound(uint64_t{0})->deadline, 1);
+    EXPECT_EQ(_deadlines.upper_bound(uint64_t{count - 1}), _deadlines.end());
+    EXPECT_EQ(_deadlines.lower_bound(uint64_t{count}), _deadlines.end());
+
+    // descending order flips which side the bounds fall on.
+    for (auto& timer : _timers) {
+      _ids.insert(timer);
+    }
+    EXPECT_EQ(_ids.lower_bound(uint64_t{30})->id, 30);
+    EXPECT_EQ(_ids.upper_bound(uint64_t{30})->id, 29);
+    EXPECT_EQ(_ids.upper_bound(uint64_t{0}), _ids.end());
+  }
+
+  TEST_F(TreeKeyTest, EqualRangeTest) {
+    // four timers share each deadline. the fixture's timers are reused, since
+    // they outlive the tree they go into.
+    for (auto& timer : _timers) {
+      timer.deadline /= 4;
+      _deadlines.insert(timer);
+    }
+
+    for (auto deadline = 0u; deadline < count / 4; deadline++) {
+      auto range = _deadlines.equal_range(uint64_t{deadline});
+      auto found = 0u;
+      for (auto each = range.first; each != range.second; ++each) {
+        EXPECT_EQ(each->deadline, deadline);
+        found++;
+      }
+      EXPECT_EQ(found, 4);
+    }
+
+    auto missing = _deadlines.equal_range(uint64_t{count});
+    EXPECT_EQ(missing.first, _deadlines.end());
+    EXPECT_EQ(missing.second, _deadlines.end());
+
+    // and the same by node.
+    auto range = _deadlines.equal_range(_timers[0]);
+    EXPECT_EQ(range.first->deadline, 0);
+    EXPECT_EQ(range.second->deadline, 1);
+  }
+
+  TEST_F(TreeTest, BoundsByNodeTest) {
+    for (auto index = 0u; index < count; index += 2) {
+      _tree.insert(_nodes[index]);
+    }
+
+    test_node odd{33};
+    EXPECT_EQ(_tree.lower_bound(odd)->value, 34);
+    EXPECT_EQ(_tree.upper_bound(odd)->value, 34);
+    EXPECT_EQ(_tree.lower_bound(_nodes[34])->value, 34);
+    EXPECT_EQ(_tree.upper_bound(_nodes[34])->value, 36);
+
+    auto range = _tree.equal_range(_nodes[34]);
+    EXPECT_EQ(&*range.first, &_nodes[34]);
+    EXPECT_EQ(&*range.second, &_nodes[36]);
+  }
+
+  class TreeSizeTest : public ::testing::Test {
+  public:
+    class test_node : public tree_node<test_node, pointed, identity, std::less<>, sized> {
+    public:
+      test_node(uint64_t value) :
+          value{value} {
+      }
+
+      bool operator<(const test_node& other) const {
+        return value < other.value;
+      }
+
+      // recounts the subtree by hand and checks it against the sizes kept
+      // along the way.
+      uint64_t counted() const {
+        auto prev = _prev ? _prev->get().counted() : 0;
+        auto next = _next ? _next->get().counted() : 0;
+        EXPECT_EQ(summary()._size, 1 + prev + next);
+        return 1 + prev + next;
+      }
+
+      uint64_t value;
+    };
+
+  protected:
+    static constexpr unsigned int count = 128;
+
+    std::vector<test_node> _nodes;
+    tree<test_node, pointed, identity, std::less<>, sized> _tree;
+
+    void SetUp() override {
+      _nodes.reserve(count);
+      for (auto value = 0u; value < count; value++) {
+        _nodes.emplace_back(value);
+      }
+    }
+  };
+
+  TEST_F(TreeSizeTest, SelectRankTest) {
+    std::vector<unsigned int> order(count);
+    for (auto index = 0u; index < count; index++) {
+      order[index] = index;
+    }
+
+    std::mt19937 engine{54321};
+    std::shuffle(order.begin(), order.end(), engine);
+    for (auto index : order) {
+      _tree.insert(_nodes[index]);
+      EXPECT_EQ(_tree.root()->counted(), _tree.size());
+    }
+
+    EXPECT_EQ(_tree.size(), count);
+    for (auto index = 0u; index < count; index++) {
+      EXPECT_EQ(&*_tree.select(index), &_nodes[index]);
+      EXPECT_EQ(_tree.rank(_nodes[index]), index);
+    }
+    EXPECT_EQ(_tree.select(count), _tree.end());
+
+    std::shuffle(order.begin(), order.end(), engine);
+    for (auto removed = 0u; removed < count; removed++) {
+      _tree.remove(_nodes[order[removed]]);
+      EXPECT_EQ(_nodes[order[removed]].summary()._size, 1);
+      EXPECT_EQ(_tree.size(), count - removed - 1);
+      if (!_tree.empty()) {
+        EXPECT_EQ(_tree.root()->counted(), _tree.size());
+      }
+
+      auto rank = 0u;
+      for (auto& node : _tree) {
+        EXPECT_EQ(_tree.rank(node), rank);
+        EXPECT_EQ(&*_tree.select(rank), &node);
+        rank++;
+      }
+    }
+
+    EXPECT_TRUE(_tree.empty());
+    EXPECT_EQ(_tree.size(), 0);
+  }
+
+  TEST_F(TreeSizeTest, AssignSortedTest) {
+    _tree.assign_sorted(_nodes.begin(), _nodes.end());
+    EXPECT_EQ(_tree.root()->counted(), count);
+    for (auto index = 0u; index < count; index++) {
+      EXPECT_EQ(_tree.rank(_nodes[index]), index);
+    }
+
+    _tree.assign_sorted(_nodes.begin() + 1, _nodes.begin() + 4);
+    EXPECT_EQ(_tree.root()->counted(), 3);
+    EXPECT_EQ(_tree.select(0)->value, 1);
+    EXPECT_TRUE(_nodes[0].alone());
+  }
+
+  TEST_F(TreeSizeTest, SplitJoinTest) {
+    for (auto& node : _nodes) {
+      _tree.insert(node);
+    }
+
+    auto [lower, upper] = _tree.split(_nodes[count / 3]);
+    EXPECT_EQ(lower.size(), count / 3);
+    EXPECT_EQ(upper.size(), count - count / 3);
+    EXPECT_EQ(lower.root()->counted(), lower.size());
+    EXPECT_EQ(upper.root()->counted(), upper.size());
+    EXPECT_EQ(upper.rank(_nodes[count / 3 + 5]), 5);
+
+    _tree = decltype(_tree)::join(std::move(lower), std::move(upper));
+    EXPECT_EQ(_tree.root()->counted(), count);
+    for (auto index = 0u; index < count; index++) {
+      EXPECT_EQ(&*_tree.select(index), &_nodes[index]);
+    }
+  }
+
+  TEST_F(TreeSizeTest, MoveTest) {
+    for (auto& node : _nodes) {
+      _tree.insert(node);
+    }
+
+    // a node that is moved out of the tree leaves its replacement in exactly
+    // the same place, so the sizes carry over untouched.
+    test_node moved{std::move(_nodes[count / 2])};
+    EXPECT_TRUE(_nodes[count / 2].alone());
+    EXPECT_EQ(_nodes[count / 2].summary()._size, 1);
+    EXPECT_EQ(_tree.root()->counted(), count);
+    EXPECT_EQ(_tree.rank(moved), count / 2);
+    EXPECT_EQ(&*_tree.select(count / 2), &moved);
+
+    _tree.remove(moved);
+  }
+
+  class TreeSpanTest : public ::testing::Test {
+  public:
+    class test_lease;
+
+    class start_of {
+    public:
+      uint64_t operator()(const test_lease& lease) const;
+    };
+
+    class end_of {
+    public:
+      uint64_t operator()(const test_lease& lease) const;
+    };
+
+    using span = spanned<uint64_t, start_of, end_of>;
+
+    class test_lease : public tree_node<test_lease, pointed, start_of, std::less<>, span> {
+    public:
+      test_lease(uint64_t start, uint64_t end) :
+          start{start}, end{end} {
+      }
+
+      bool overlaps(uint64_t low, uint64_t high) const {
+        return start < high && low < end;
+      }
+
+      uint64_t start;
+      uint64_t end;
+    };
+
+  protected:
+    static constexpr unsigned int count = 256;
+
+    std::vector<test_lease> _leases;
+    tree<test_lease, pointed, start_of, std::less<>, span> _tree;
+
+    void SetUp() override {
+      std::mt19937 engine{24680};
+      std::uniform_int_distribution<uint64_t> starts{0, 4096};
+      std::uniform_int_distribution<uint64_t> lengths{1, 256};
+
+      _leases.reserve(count);
+      for (auto index = 0u; index < count; index++) {
+        auto start = starts(engine);
+        _leases.emplace_back(start, start + lengths(engine));
+      }
+    }
+
+    // the leases that overlap [low, high), found through the spans.
+    std::vector<const test_lease*> overlapping(uint64_t low, uint64_t high) const {
+      std::vector<const test_lease*> found;
+      _tree.visit([&](const span& summary) {
+        return summary._low < high && low < summary._high;
+      }, [&](const test_lease& lease) {
+        if (lease.overlaps(low, high)) {
+          found.push_back(&lease);
+        }
+      });
+      return found;
+    }
+
+    // and the same, by looking at every lease still in the tree.
+    std::vector<const test_lease*> scanned(uint64_t low, uint64_t high) const {
+      std::vector<const test_lease*> found;
+      for (auto& lease : _tree) {
+        if (lease.overlaps(low, high)) {
+          found.push_back(&lease);
+        }
+      }
+      return found;
+    }
+  };
+
+  uint64_t TreeSpanTest::start_of::operator()(const test_lease& lease) const {
+    return lease.start;
+  }
+
+  uint64_t TreeSpanTest::end_of::operator()(const test_lease& lease) const {
+    return lease.end;
+  }
+
+  TEST_F(TreeSpanTest, SpanTest) {
+    for (auto& lease : _leases) {
+      _tree.insert(lease);
+    }
+
+    auto low = std::numeric_limits<uint64_t>::max();
+    auto high = 0lu;
+    for (auto& lease : _leases) {
+      low = std::min(low, lease.start);
+      high = std::max(high, lease.end);
+    }
+
+    auto& root = *_tree.root();
+    EXPECT_EQ(root.summary()._low, low);
+    EXPECT_EQ(root.summary()._high, high);
+  }
+
+  TEST_F(TreeSpanTest, OverlapTest) {
+    for (auto& lease : _leases) {
+      _tree.insert(lease);
+    }
+
+    std::mt19937 engine{13579};
+    std::uniform_int_distribution<uint64_t> points{0, 4500};
+    std::vector<unsigned int> order(count);
+    for (auto index = 0u; index < count; index++) {
+      order[index] = index;
+    }
+    std::shuffle(order.begin(), order.end(), engine);
+
+    // the spans have to follow the removals as well as the insertions.
+    for (auto removed = 0u; removed < count; removed += 8) {
+      for (auto query = 0u; query < 16; query++) {
+        auto low = points(engine);
+        auto high = low + points(engine) / 16;
+        EXPECT_EQ(overlapping(low, high), scanned(low, high));
+      }
+      for (auto index = removed; index < removed + 8; index++) {
+        _tree.remove(_leases[order[index]]);
+      }
+    }
+
+    EXPECT_TRUE(_tree.empty());
+    EXPECT_TRUE(overlapping(0, 4500).empty());
+  }
+
+  class TreeLinkTest : public ::testing::Test {
+  public:
+    template <template <class> class Link>
+    class test_node : public tree_node<test_node<Link>, Link> {
+    public:
+      using node = tree_node<test_node<Link>, Link>;
+
+      test_node(uint32_t value) :
+          value{value} {
+      }
+
+      bool operator<(const test_node& other) const {
+        return value < other.value;
+      }
+
+      // the black height below this node, or -1 if the paths down from it
+      // disagree or a red node has a red child.
+      int black_depth() const {
+        auto* prev = this->_prev ? &this->_prev->get() : nullptr;
+        auto* next = this->_next ? &this->_next->get() : nullptr;
+        if (node::is_red() && ((prev && prev->node::is_red()) || (next && next->node::is_red()))) {
+          return -1;
+        }
+        auto prev_depth = prev ? prev->black_depth() : 0;
+        auto next_depth = next ? next->black_depth() : 0;
+        if (prev_depth < 0 || next_depth < 0 || prev_depth != next_depth) {
+          return -1;
+        }
+        return prev_depth + (node::is_black() ? 1 : 0);
+      }
+
+      uint32_t value;
+    };
+
+  protected:
+    static constexpr unsigned int count = 512;
+
+    template <template <class> class Link>
+    static std::vector<test_node<Link>> populate() {
+      std::vector<test_node<Link>> nodes;
+      nodes.reserve(count);
+      for (auto value = 0u; value < count; value++) {
+        nodes.emplace_back(2 * value);
+      }
+      return nodes;
+    }
+
+    template <template <class> class Link>
+    void shuffled(std::vector<test_node<Link>>& nodes, uint64_t seed) {
+      tree<test_node<Link>, Link> tree;
+
+      std::vector<unsigned int> order(count);
+      for (auto index = 0u; index < count; index++) {
+        order[index] = index;
+      }
+
+      std::mt19937 engine{seed};
+      std::shuffle(order.begin(), order.end(), engine);
+      for (auto index : order) {
+        tree.insert(nodes[index]);
+      }
+      EXPECT_GT(tree.root()->get().black_depth(), 0);
+
+      auto expected = 0u;
+      for (auto& node : tree) {
+        EXPECT_EQ(node.value, 2 * expected++);
+      }
+      EXPECT_EQ(expected, count);
+
+      EXPECT_EQ(&*tree.find(nodes[100]), &nodes[100]);
+      EXPECT_EQ(tree.lower_bound(test_node<Link>{201})->value, 202u);
+      EXPECT_EQ(tree.upper_bound(nodes[300])->value, 602u);
+
+      std::shuffle(order.begin(), order.end(), engine);
+      for (auto removed = 0u; removed < count; removed++) {
+        EXPECT_GT(tree.root()->get().black_depth(), 0);
+        EXPECT_EQ(tree.remove(nodes[order[removed]]), &nodes[order[removed]]);
+        EXPECT_TRUE(nodes[order[removed]].alone());
+      }
+
+      EXPECT_TRUE(tree.empty());
+    }
+  };
+
+  // three links and nothing else: the color is folded into the one to the head.
+  static_assert(sizeof(TreeLinkTest::test_node<marked>::node) == 3 * sizeof(void*));
+  static_assert(sizeof(TreeLinkTest::test_node<indexed32>::node) == 12);
+  static_assert(sizeof(TreeLinkTest::test_node<indexed16>::node) == 6);
+
+  TEST_F(TreeLinkTest, MarkedTest) {
+    auto nodes = populate<marked>();
+    shuffled<marked>(nodes, 31415);
+  }
+
+  TEST_F(TreeLinkTest, Indexed32Test) {
+    auto nodes = populate<indexed32>();
+    auto guard = indexed32<test_node<indexed32>::node>::context{nodes.data()};
+    shuffled<indexed32>(nodes, 11235);
+  }
+
+  TEST_F(TreeLinkTest, Indexed16Test) {
+    auto nodes = populate<indexed16>();
+    auto guard = indexed16<test_node<indexed16>::node>::context{nodes.data()};
+    shuffled<indexed16>(nodes, 81321);
+  }
+
+} // namespace hatch